@@ -48,6 +48,13 @@ std::vector<InformativeSchedule> ScheduleFilter::filterSchedules(const std::vect
             }
         }
 
+        // Check Earliest Start Filter
+        if (criteria.earliestStartEnabled && passesAllFilters) {
+            if (!meetsEarliestStartCriteria(schedule, criteria)) {
+                passesAllFilters = false;
+            }
+        }
+
         if (passesAllFilters) {
             filtered.push_back(schedule);
         }
@@ -58,6 +65,64 @@ std::vector<InformativeSchedule> ScheduleFilter::filterSchedules(const std::vect
     return filtered;
 }
 
+ScheduleConstraints ScheduleFilter::toConstraints(const FilterCriteria& criteria) {
+    ScheduleConstraints constraints;
+
+    if (criteria.daysToStudyEnabled) {
+        constraints.maxDays = criteria.daysToStudyValue;
+    }
+    if (criteria.totalGapsEnabled) {
+        constraints.maxGaps = criteria.totalGapsValue;
+    }
+    if (criteria.maxGapsTimeEnabled) {
+        constraints.maxGapMinutes = criteria.maxGapsTimeValue;
+    }
+    if (criteria.avgDayStartEnabled) {
+        constraints.minAvgStart = timeToMinutes(criteria.avgDayStartHour, criteria.avgDayStartMinute);
+    }
+    if (criteria.avgDayEndEnabled) {
+        constraints.maxAvgEnd = timeToMinutes(criteria.avgDayEndHour, criteria.avgDayEndMinute);
+    }
+    if (criteria.earliestStartEnabled) {
+        constraints.earliestStart = timeToMinutes(criteria.earliestStartHour, criteria.earliestStartMinute);
+    }
+
+    return constraints;
+}
+
+ScheduleFilter::FilterCriteria ScheduleFilter::criteriaFromMap(const QVariantMap& filterData) {
+    FilterCriteria criteria;
+
+    const QVariantMap days = filterData.value("daysToStudy").toMap();
+    criteria.daysToStudyEnabled = days.value("enabled").toBool();
+    criteria.daysToStudyValue = days.value("value", criteria.daysToStudyValue).toInt();
+
+    const QVariantMap gaps = filterData.value("totalGaps").toMap();
+    criteria.totalGapsEnabled = gaps.value("enabled").toBool();
+    criteria.totalGapsValue = gaps.value("value", criteria.totalGapsValue).toInt();
+
+    const QVariantMap gapsTime = filterData.value("maxGapsTime").toMap();
+    criteria.maxGapsTimeEnabled = gapsTime.value("enabled").toBool();
+    criteria.maxGapsTimeValue = gapsTime.value("value", criteria.maxGapsTimeValue).toInt();
+
+    const QVariantMap avgStart = filterData.value("avgDayStart").toMap();
+    criteria.avgDayStartEnabled = avgStart.value("enabled").toBool();
+    criteria.avgDayStartHour = avgStart.value("hour", criteria.avgDayStartHour).toInt();
+    criteria.avgDayStartMinute = avgStart.value("minute", criteria.avgDayStartMinute).toInt();
+
+    const QVariantMap avgEnd = filterData.value("avgDayEnd").toMap();
+    criteria.avgDayEndEnabled = avgEnd.value("enabled").toBool();
+    criteria.avgDayEndHour = avgEnd.value("hour", criteria.avgDayEndHour).toInt();
+    criteria.avgDayEndMinute = avgEnd.value("minute", criteria.avgDayEndMinute).toInt();
+
+    const QVariantMap earliest = filterData.value("earliestStart").toMap();
+    criteria.earliestStartEnabled = earliest.value("enabled").toBool();
+    criteria.earliestStartHour = earliest.value("hour", criteria.earliestStartHour).toInt();
+    criteria.earliestStartMinute = earliest.value("minute", criteria.earliestStartMinute).toInt();
+
+    return criteria;
+}
+
 int ScheduleFilter::countActiveDays(const InformativeSchedule& schedule) {
     int activeDays = 0;
 
@@ -95,18 +160,15 @@ bool ScheduleFilter::meetsTotalGapsCriteria(const InformativeSchedule& schedule,
         // Sort items by start time for gap calculation
         std::vector<ScheduleItem> sortedItems = day.day_items;
         std::sort(sortedItems.begin(), sortedItems.end(), [](const ScheduleItem& a, const ScheduleItem& b) {
-            return timeToMinutes(std::stoi(a.start.substr(0, 2)), std::stoi(a.start.substr(3, 2))) <
-                   timeToMinutes(std::stoi(b.start.substr(0, 2)), std::stoi(b.start.substr(3, 2)));
+            return a.start_minutes < b.start_minutes;
         });
 
         // Count gaps between consecutive items
         for (size_t i = 0; i < sortedItems.size() - 1; ++i) {
-            int currentEndTime = timeToMinutes(std::stoi(sortedItems[i].end.substr(0, 2)),
-                                               std::stoi(sortedItems[i].end.substr(3, 2)));
-            int nextStartTime = timeToMinutes(std::stoi(sortedItems[i+1].start.substr(0, 2)),
-                                              std::stoi(sortedItems[i+1].start.substr(3, 2)));
+            int currentEndTime = sortedItems[i].end_minutes;
+            int nextStartTime = sortedItems[i+1].start_minutes;
 
-            if (nextStartTime > currentEndTime) {
+            if (nextStartTime - currentEndTime >= MIN_GAP_MINUTES) {
                 totalGaps++;
             }
         }
@@ -130,18 +192,15 @@ bool ScheduleFilter::meetsMaxGapsTimeCriteria(const InformativeSchedule& schedul
         // Sort items by start time
         std::vector<ScheduleItem> sortedItems = day.day_items;
         std::sort(sortedItems.begin(), sortedItems.end(), [](const ScheduleItem& a, const ScheduleItem& b) {
-            return timeToMinutes(std::stoi(a.start.substr(0, 2)), std::stoi(a.start.substr(3, 2))) <
-                   timeToMinutes(std::stoi(b.start.substr(0, 2)), std::stoi(b.start.substr(3, 2)));
+            return a.start_minutes < b.start_minutes;
         });
 
         // Find maximum gap time
         for (size_t i = 0; i < sortedItems.size() - 1; ++i) {
-            int currentEndTime = timeToMinutes(std::stoi(sortedItems[i].end.substr(0, 2)),
-                                               std::stoi(sortedItems[i].end.substr(3, 2)));
-            int nextStartTime = timeToMinutes(std::stoi(sortedItems[i+1].start.substr(0, 2)),
-                                              std::stoi(sortedItems[i+1].start.substr(3, 2)));
+            int currentEndTime = sortedItems[i].end_minutes;
+            int nextStartTime = sortedItems[i+1].start_minutes;
 
-            if (nextStartTime > currentEndTime) {
+            if (nextStartTime - currentEndTime >= MIN_GAP_MINUTES) {
                 int gapTime = nextStartTime - currentEndTime;
                 maxGapTime = std::max(maxGapTime, gapTime);
             }
@@ -167,9 +226,7 @@ bool ScheduleFilter::meetsAvgDayStartCriteria(const InformativeSchedule& schedul
         // Find earliest start time for this day
         int earliestStart = 24 * 60; // 24 hours in minutes
         for (const auto& item : day.day_items) {
-            int startTime = timeToMinutes(std::stoi(item.start.substr(0, 2)),
-                                          std::stoi(item.start.substr(3, 2)));
-            earliestStart = std::min(earliestStart, startTime);
+            earliestStart = std::min(earliestStart, item.start_minutes);
         }
 
         totalStartTime += earliestStart;
@@ -203,9 +260,7 @@ bool ScheduleFilter::meetsAvgDayEndCriteria(const InformativeSchedule& schedule,
         // Find latest end time for this day
         int latestEnd = 0;
         for (const auto& item : day.day_items) {
-            int endTime = timeToMinutes(std::stoi(item.end.substr(0, 2)),
-                                        std::stoi(item.end.substr(3, 2)));
-            latestEnd = std::max(latestEnd, endTime);
+            latestEnd = std::max(latestEnd, item.end_minutes);
         }
 
         totalEndTime += latestEnd;
@@ -223,6 +278,25 @@ bool ScheduleFilter::meetsAvgDayEndCriteria(const InformativeSchedule& schedule,
     return avgEndTime <= criteriaEndTime;
 }
 
+bool ScheduleFilter::meetsEarliestStartCriteria(const InformativeSchedule& schedule, const FilterCriteria& criteria) {
+    if (!criteria.earliestStartEnabled) {
+        return true;
+    }
+
+    int criteriaStartTime = timeToMinutes(criteria.earliestStartHour, criteria.earliestStartMinute);
+
+    // No session may start before the specified time
+    for (const auto& day : schedule.week) {
+        for (const auto& item : day.day_items) {
+            if (item.start_minutes < criteriaStartTime) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 // Helper methods
 int ScheduleFilter::timeToMinutes(int hour, int minute) {
     return hour * 60 + minute;
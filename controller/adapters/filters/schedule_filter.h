@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <QObject>
 #include <QDebug>
+#include <QVariantMap>
 #include <vector>
 
 #include "model_interfaces.h"
@@ -37,18 +38,30 @@ public:
         bool avgDayEndEnabled = false;
         int avgDayEndHour = 17;
         int avgDayEndMinute = 0;
+
+        // Earliest Start Filter (no session starts before it)
+        bool earliestStartEnabled = false;
+        int earliestStartHour = 8;
+        int earliestStartMinute = 0;
     };
 
     // Main filtering method
     vector<InformativeSchedule> filterSchedules(const vector<InformativeSchedule>& schedules,
                                                 const FilterCriteria& criteria);
 
+    // The same criteria as generation constraints, so failing schedules are never generated
+    static ScheduleConstraints toConstraints(const FilterCriteria& criteria);
+
+    // Criteria sent from QML, one {enabled, value} or {enabled, hour, minute} map per filter
+    static FilterCriteria criteriaFromMap(const QVariantMap& filterData);
+
     static int countActiveDays(const InformativeSchedule& schedule);
     static bool meetsDaysToStudyCriteria(const InformativeSchedule& schedule, const FilterCriteria& criteria);
     static bool meetsTotalGapsCriteria(const InformativeSchedule& schedule, const FilterCriteria& criteria);
     static bool meetsMaxGapsTimeCriteria(const InformativeSchedule& schedule, const FilterCriteria& criteria);
     static bool meetsAvgDayStartCriteria(const InformativeSchedule& schedule, const FilterCriteria& criteria);
     static bool meetsAvgDayEndCriteria(const InformativeSchedule& schedule, const FilterCriteria& criteria);
+    static bool meetsEarliestStartCriteria(const InformativeSchedule& schedule, const FilterCriteria& criteria);
 
 signals:
     void filteringStarted();
@@ -1,12 +1,67 @@
 #include "ScheduleGenerator.h"
 
-ScheduleGenerator::ScheduleGenerator(IModel* modelConn, const std::vector<Course>& courses, QObject* parent)
+ScheduleGenerator::ScheduleGenerator(IModel* modelConn, const std::vector<Course>& courses,
+                                     const std::vector<Session>& blockedTimes,
+                                     const ScheduleConstraints& constraints,
+                                     std::shared_ptr<const ScheduleStore> previousSchedules,
+                                     std::shared_ptr<ScheduleBatchChannel> batchChannel,
+                                     std::shared_ptr<CancellationToken> cancellation, QObject* parent)
         : QObject(parent),
           modelConnection(modelConn),
-          selectedCourses(courses) {}
+          channel(std::move(batchChannel)) {
+    request.courses = courses;
+    request.blockedTimes = blockedTimes;
+    request.constraints = constraints;
+    request.previous = std::move(previousSchedules);
+    request.collapseSameTimes = true;
+    request.batchSize = BATCH_SIZE;
+    request.budget = {MAX_RESULTS, MAX_MEMORY_BYTES, MAX_TIME};
+    request.cancellation = std::move(cancellation);
+
+    // Runs on the builder's threads, the builder already throttles it
+    request.onProgress = [this](double explored) {
+        emit progressChanged(explored);
+    };
+
+    // Runs on one builder thread at a time; blocks while the channel is full, the other threads keep searching,
+    // and stops the search once the channel is closed
+    request.onBatch = [this](ScheduleStore&& batch) {
+        if (!channel->push(std::move(batch))) {
+            return false;
+        }
+        emit schedulesBatchReady();
+        return true;
+    };
+}
 
 void ScheduleGenerator::generateSchedules() {
-    auto* schedulePtr = static_cast<std::vector<InformativeSchedule>*>
-    (modelConnection->executeOperation(ModelOperation::GENERATE_SCHEDULES, &selectedCourses, ""));
-    emit schedulesGenerated(schedulePtr);
-}
\ No newline at end of file
+    // Aborted before the thread got to run
+    if (request.cancellation && request.cancellation->isCancelled()) {
+        emit schedulesGenerated(nullptr);
+        return;
+    }
+
+    // Counting is far cheaper than generating and lets the view tell how big the run is, but it runs next to
+    // the generation so the first batches do not wait for it. Once the generation is done it is no longer needed.
+    ScheduleGenerationRequest countRequest;
+    countRequest.courses = request.courses;
+    countRequest.blockedTimes = request.blockedTimes;
+    countRequest.constraints = request.constraints;
+    countRequest.collapseSameTimes = request.collapseSameTimes;
+    countRequest.cancellation = std::make_shared<CancellationToken>();
+
+    std::thread counter([this, &countRequest]() {
+        std::unique_ptr<size_t> count(static_cast<size_t*>
+        (modelConnection->executeOperation(ModelOperation::COUNT_SCHEDULES, &countRequest, "")));
+        if (count) {
+            emit scheduleCountReady(static_cast<qulonglong>(*count));
+        }
+    });
+
+    std::shared_ptr<ScheduleStore> schedules(static_cast<ScheduleStore*>
+    (modelConnection->executeOperation(ModelOperation::GENERATE_SCHEDULES, &request, "")));
+
+    countRequest.cancellation->cancel();
+    counter.join();
+    emit schedulesGenerated(std::move(schedules));
+}
@@ -1,22 +1,49 @@
 #pragma once
 #include <QObject>
+#include <memory>
+#include <thread>
 #include <vector>
 #include "model_access.h"
 #include "model_interfaces.h"
+#include "BoundedChannel.h"
+#include "ScheduleStore.h"
+
+using ScheduleBatchChannel = BoundedChannel<ScheduleStore>;
+
+Q_DECLARE_METATYPE(std::shared_ptr<ScheduleStore>)
 
 class ScheduleGenerator : public QObject {
 Q_OBJECT
 
 public:
-    ScheduleGenerator(IModel* modelConn, const std::vector<Course>& courses, QObject* parent = nullptr);
+    ScheduleGenerator(IModel* modelConn, const std::vector<Course>& courses, const std::vector<Session>& blockedTimes,
+                      const ScheduleConstraints& constraints,
+                      std::shared_ptr<const ScheduleStore> previousSchedules,
+                      std::shared_ptr<ScheduleBatchChannel> batchChannel,
+                      std::shared_ptr<CancellationToken> cancellation, QObject* parent = nullptr);
 
 public slots:
     void generateSchedules();
 
 signals:
-    void schedulesGenerated(std::vector<InformativeSchedule>* schedules);
+    // Number of schedules the generation will find, counted next to it; may not come when the generation ends first
+    void scheduleCountReady(qulonglong count);
+    // A batch was queued on the channel, emitted once per batch
+    void schedulesBatchReady();
+    // Explored fraction of the search, from 0 to 1
+    void progressChanged(double explored);
+    // Schedules that were not streamed, owned by the signal so another generation cannot replace them
+    void schedulesGenerated(std::shared_ptr<ScheduleStore> schedules);
 
 private:
     IModel* modelConnection;
-    std::vector<Course> selectedCourses;
-};
\ No newline at end of file
+    ScheduleGenerationRequest request;
+    std::shared_ptr<ScheduleBatchChannel> channel;
+
+    inline static const size_t BATCH_SIZE = 64;
+
+    // Budget of a generation started from the view, large selections stop here with the schedules found so far
+    inline static const size_t MAX_RESULTS = 2000000;
+    inline static const size_t MAX_MEMORY_BYTES = 256 * 1024 * 1024;
+    inline static const std::chrono::milliseconds MAX_TIME{60000};
+};
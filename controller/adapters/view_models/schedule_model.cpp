@@ -1,39 +1,100 @@
 #include "schedule_model.h"
+#include "TimeUtils.h"
 
 ScheduleModel::ScheduleModel(QObject *parent)
         : QObject(parent), m_currentScheduleIndex(0) {
 }
 
-void ScheduleModel::loadSchedules(const std::vector<InformativeSchedule>& schedules) {
+void ScheduleModel::loadSchedules(const ScheduleStore* schedules, const std::vector<size_t>* order) {
     m_schedules = schedules;
+    m_order = order;
+    m_cachedIndex = -1;
+    m_currentVariant = 0;
     setCurrentScheduleIndex(0);
 
     emit scheduleCountChanged();
     emit scheduleDataChanged();
 }
 
+// Schedules arrived while generation is still running. The shown schedule stays unless a ranking
+// moved better ones ahead of it.
+void ScheduleModel::schedulesAppended(bool reordered) {
+    if (reordered) {
+        m_cachedIndex = -1;
+        m_currentVariant = 0;
+        emit currentVariantChanged();
+        emit scheduleDataChanged();
+    }
+    emit scheduleCountChanged();
+    // canGoNext may have changed
+    emit currentScheduleIndexChanged();
+}
+
+InformativeSchedule ScheduleModel::scheduleAt(int index) const {
+    const InformativeSchedule* schedule = materialized(index);
+    return schedule ? *schedule : InformativeSchedule{};
+}
+
+const InformativeSchedule* ScheduleModel::materialized(int index) const {
+    if (!m_schedules || index < 0 || index >= scheduleCount())
+        return nullptr;
+
+    int variant = index == m_currentScheduleIndex ? m_currentVariant : 0;
+    if (m_cachedIndex != index || m_cachedVariant != variant) {
+        m_cachedSchedule = m_schedules->materialize((*m_order)[index], variant);
+        m_cachedIndex = index;
+        m_cachedVariant = variant;
+    }
+    return &m_cachedSchedule;
+}
+
 void ScheduleModel::setCurrentScheduleIndex(int index) {
-    if (index >= 0 && index < static_cast<int>(m_schedules.size()) && m_currentScheduleIndex != index) {
+    if (index >= 0 && index < scheduleCount() && m_currentScheduleIndex != index) {
         m_currentScheduleIndex = index;
+        m_currentVariant = 0;
         emit currentScheduleIndexChanged();
+        emit currentVariantChanged();
+    }
+}
+
+int ScheduleModel::variantCount() const {
+    if (!m_schedules || m_currentScheduleIndex < 0 || m_currentScheduleIndex >= scheduleCount())
+        return 0;
+
+    size_t count = m_schedules->variantCount((*m_order)[m_currentScheduleIndex]);
+    return static_cast<int>(std::min<size_t>(count, INT_MAX));
+}
+
+void ScheduleModel::nextVariant() {
+    if (m_currentVariant + 1 < variantCount()) {
+        m_currentVariant++;
+        emit currentVariantChanged();
+    }
+}
+
+void ScheduleModel::previousVariant() {
+    if (m_currentVariant > 0) {
+        m_currentVariant--;
+        emit currentVariantChanged();
     }
 }
 
 QVariantList ScheduleModel::getDayItems(int scheduleIndex, int dayIndex) const {
-    if (scheduleIndex < 0 || scheduleIndex >= static_cast<int>(m_schedules.size()))
+    const InformativeSchedule* schedule = materialized(scheduleIndex);
+    if (!schedule)
         return {};
 
-    if (dayIndex < 0 || dayIndex >= static_cast<int>(m_schedules[scheduleIndex].week.size()))
+    if (dayIndex < 0 || dayIndex >= static_cast<int>(schedule->week.size()))
         return {};
 
     QVariantList items;
-    for (const auto &item : m_schedules[scheduleIndex].week[dayIndex].day_items) {
+    for (const auto &item : schedule->week[dayIndex].day_items) {
         QVariantMap itemMap;
         itemMap["courseName"] = QString::fromStdString(item.courseName);
         itemMap["raw_id"] = QString::fromStdString(item.raw_id);
         itemMap["type"] = QString::fromStdString(item.type);
-        itemMap["start"] = QString::fromStdString(item.start);
-        itemMap["end"] = QString::fromStdString(item.end);
+        itemMap["start"] = QString::fromStdString(TimeUtils::formatMinutes(item.start_minutes));
+        itemMap["end"] = QString::fromStdString(TimeUtils::formatMinutes(item.end_minutes));
         itemMap["building"] = QString::fromStdString(item.building);
         itemMap["room"] = QString::fromStdString(item.room);
         items.append(itemMap);
@@ -58,11 +119,11 @@ void ScheduleModel::previousSchedule() {
 }
 
 bool ScheduleModel::canGoNext() const {
-    return m_currentScheduleIndex < static_cast<int>(m_schedules.size()) - 1 && !m_schedules.empty();
+    return m_currentScheduleIndex < scheduleCount() - 1 && scheduleCount() > 0;
 }
 
 bool ScheduleModel::canGoPrevious() const {
-    return m_currentScheduleIndex > 0 && !m_schedules.empty();
+    return m_currentScheduleIndex > 0 && scheduleCount() > 0;
 }
 void ScheduleModel::jumpToSchedule(int userScheduleNumber) {
     // Convert from 1-based user input to 0-based array index
@@ -76,5 +137,5 @@ void ScheduleModel::jumpToSchedule(int userScheduleNumber) {
 
 bool ScheduleModel::canJumpToSchedule(int index) {
     // Fix: include both bounds checking
-    return index >= 0 && index < static_cast<int>(m_schedules.size());
+    return index >= 0 && index < scheduleCount();
 }
\ No newline at end of file
@@ -4,6 +4,11 @@
 #include <QObject>
 #include <QVariant>
 #include "model_interfaces.h"
+#include "ScheduleStore.h"
+
+#include <algorithm>
+#include <climits>
+#include <vector>
 
 class ScheduleModel : public QObject {
 Q_OBJECT
@@ -12,19 +17,28 @@ Q_OBJECT
     Q_PROPERTY(int scheduleCount READ scheduleCount NOTIFY scheduleCountChanged)
     Q_PROPERTY(bool canGoNext READ canGoNext NOTIFY currentScheduleIndexChanged)
     Q_PROPERTY(bool canGoPrevious READ canGoPrevious NOTIFY currentScheduleIndexChanged)
+    // Same week of the current schedule in other groups or rooms
+    Q_PROPERTY(int variantCount READ variantCount NOTIFY currentScheduleIndexChanged)
+    Q_PROPERTY(int currentVariant READ currentVariant NOTIFY currentVariantChanged)
     // Q_PROPERTY(bool canJumpToSchedule READ canJumpToSchedule NOTIFY currentScheduleIndexChanged)
 
 public:
     explicit ScheduleModel(QObject *parent = nullptr);
     ~ScheduleModel() override = default;
 
-    // Schedule management
-    void loadSchedules(const vector<InformativeSchedule>& schedules);
+    // Schedule management, order maps display positions to store positions; both stay owned by the caller
+    void loadSchedules(const ScheduleStore* schedules, const std::vector<size_t>* order);
+    void schedulesAppended(bool reordered);
+
+    // Materialized schedule at a display position, the current schedule in its current variant
+    InformativeSchedule scheduleAt(int index) const;
 
     // Properties
     int currentScheduleIndex() const { return m_currentScheduleIndex; }
     Q_INVOKABLE void setCurrentScheduleIndex(int index);
-    int scheduleCount() const { return static_cast<int>(m_schedules.size()); }
+    int scheduleCount() const { return m_order ? static_cast<int>(m_order->size()) : 0; }
+    int variantCount() const;
+    int currentVariant() const { return m_currentVariant; }
 
     // QML accessible methods
     Q_INVOKABLE QVariantList getDayItems(int scheduleIndex, int dayIndex) const;
@@ -35,15 +49,27 @@ public:
     Q_INVOKABLE bool canGoPrevious() const;
     Q_INVOKABLE bool canJumpToSchedule(int index) ;
     Q_INVOKABLE void jumpToSchedule(int index) ;
+    Q_INVOKABLE void nextVariant();
+    Q_INVOKABLE void previousVariant();
 
 signals:
     void currentScheduleIndexChanged();
+    void currentVariantChanged();
     void scheduleCountChanged();
     void scheduleDataChanged();
 
 private:
-    vector<InformativeSchedule> m_schedules;
+    const ScheduleStore* m_schedules = nullptr;
+    const std::vector<size_t>* m_order = nullptr;
     int m_currentScheduleIndex;
+    int m_currentVariant = 0;
+
+    // QML asks for one day at a time, so the last materialized schedule is kept
+    mutable int m_cachedIndex = -1;
+    mutable int m_cachedVariant = 0;
+    mutable InformativeSchedule m_cachedSchedule;
+
+    const InformativeSchedule* materialized(int index) const;
 };
 
 #endif // SCHEDULE_MODEL_H
\ No newline at end of file
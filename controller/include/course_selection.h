@@ -7,9 +7,12 @@
 #include "model_access.h"
 #include "controller_manager.h"
 #include "schedules_display.h"
+#include "schedule_filter.h"
+#include "TimeUtils.h"
 #include "logger.h"
 
 #include <algorithm>
+#include <memory>
 #include <QUrl>
 #include <QStringList>
 #include <QThread>
@@ -39,6 +42,8 @@ Q_OBJECT
     Q_PROPERTY(CourseModel* blocksModel READ blocksModel CONSTANT)
     Q_PROPERTY(bool validationInProgress READ validationInProgress NOTIFY validationStateChanged)
     Q_PROPERTY(QStringList validationErrors READ validationErrors NOTIFY validationStateChanged)
+    Q_PROPERTY(qint64 expectedScheduleCount READ expectedScheduleCount NOTIFY scheduleCountChanged)
+    Q_PROPERTY(double generationProgress READ generationProgress NOTIFY generationProgressChanged)
 
 public:
     explicit CourseSelectionController(QObject *parent = nullptr);
@@ -50,6 +55,8 @@ public:
     [[nodiscard]] CourseModel* blocksModel() const { return m_blocksModel; }
     [[nodiscard]] bool validationInProgress() const { return m_validationInProgress; }
     [[nodiscard]] QStringList validationErrors() const { return m_validationErrors; }
+    [[nodiscard]] qint64 expectedScheduleCount() const { return m_expectedScheduleCount; }
+    [[nodiscard]] double generationProgress() const { return m_generationProgress; }
 
     void initiateCoursesData(const vector<Course>& courses);
 
@@ -58,6 +65,7 @@ public:
     Q_INVOKABLE void filterCourses(const QString &text);
     Q_INVOKABLE void resetFilter();
     Q_INVOKABLE void generateSchedules();
+    Q_INVOKABLE void abortGeneration();
     Q_INVOKABLE void deselectCourse(int index);
     Q_INVOKABLE void createNewCourse(const QString& courseName, const QString& courseId,
                                      const QString& teacherName, const QVariantList& sessionGroups);
@@ -65,11 +73,16 @@ public:
     Q_INVOKABLE void addBlockTime(const QString& day, const QString& startTime, const QString& endTime);
     Q_INVOKABLE void removeBlockTime(int index);
     Q_INVOKABLE void clearAllBlockTimes();
+    // Filters the next generation applies while searching, instead of dropping schedules after it
+    Q_INVOKABLE void setScheduleFilters(const QVariantMap& filterData);
 
     Q_INVOKABLE void setupValidationTimeout(int timeoutMs);
 
 private slots:
-    void onSchedulesGenerated(vector<InformativeSchedule>* schedules);
+    void onScheduleCountReady(qulonglong count);
+    void onScheduleBatchReady();
+    void onGenerationProgress(double explored);
+    void onSchedulesGenerated(std::shared_ptr<ScheduleStore> schedules);
     void onValidationTimeout();
 
 signals:
@@ -77,6 +90,8 @@ signals:
     void blockTimesChanged();
     void errorMessage(const QString &message);
     void validationStateChanged();
+    void scheduleCountChanged();
+    void generationProgressChanged();
 
 private:
     CourseModel* m_courseModel;
@@ -87,11 +102,14 @@ private:
     bool validationCompleted = false;
     bool m_validationInProgress = false;
     QStringList m_validationErrors;
+    qint64 m_expectedScheduleCount = -1;  // -1 until the running generation counted its schedules
+    double m_generationProgress = -1;     // -1 until the running generation reported progress
     vector<Course> allCourses;
     vector<Course> selectedCourses;
     vector<Course> filteredCourses;
     vector<Course> blockTimes;
     vector<BlockTime> userBlockTimes;
+    ScheduleFilter::FilterCriteria scheduleFilters;
 
     vector<int> selectedIndices;
     vector<int> filteredIndicesMap;
@@ -99,9 +117,16 @@ private:
     IModel* modelConnection;
     QThread* validatorThread = nullptr;
     QThread* workerThread = nullptr;
+    std::shared_ptr<ScheduleBatchChannel> scheduleChannel;
+    std::shared_ptr<CancellationToken> generationCancellation;
+    QObject* activeGenerator = nullptr;
+    int streamedScheduleCount = 0;
+    // Every schedule of the last generation that ran to its end, shared with the schedules display.
+    // The next generation extends them when it only adds a course.
+    std::shared_ptr<const ScheduleStore> completeSchedules;
 
     void updateBlockTimesModel();
-    Course createSingleBlockTimeCourse();
+    vector<Session> createBlockedTimes() const;
     static int getDayNumber(const QString& dayName);
     Course createCourseFromData(const QString& courseName, const QString& courseId,
                                 const QString& teacherName, const QVariantList& sessionGroups);
@@ -111,10 +136,16 @@ private:
     void cleanupValidatorThread();
     void setValidationInProgress(bool inProgress);
     void setValidationErrors(const QStringList& errors);
+    void stopActiveGeneration();
+    void drainScheduleBatches();
+    void showSchedules(const ScheduleStore& schedules);
+    void hideLoadingOverlay();
 
     inline static const int VALIDATION_TIMEOUT_MS = 60000;
     inline static const int THREAD_CLEANUP_TIMEOUT_MS = 10000;
     inline static const int MAX_COURSES_LIMIT = 1000;
+    inline static const int SCHEDULE_CHANNEL_CAPACITY = 16;
+    inline static const qulonglong LARGE_SCHEDULE_COUNT = 100000;
 };
 
 #endif //COURSE_SELECTION_H
@@ -5,6 +5,8 @@
 #include "model_access.h"
 #include "model_interfaces.h"
 #include "schedule_model.h"
+#include "ScheduleStore.h"
+#include "ScheduleRanking.h"
 
 #include <QObject>
 #include <QVariant>
@@ -30,7 +32,11 @@ class SchedulesDisplayController : public ControllerManager {
     explicit SchedulesDisplayController(QObject *parent = nullptr);
     ~SchedulesDisplayController() override;
 
-    void loadScheduleData(const std::vector<InformativeSchedule>& schedules);
+    void loadScheduleData(const ScheduleStore& schedules);
+    void appendScheduleData(const ScheduleStore& schedules);
+
+    // The shown schedules; loading new ones replaces the store instead of changing it, so holders keep theirs
+    std::shared_ptr<const ScheduleStore> scheduleStore() const { return m_schedules; }
 
     // Properties
     ScheduleModel* scheduleModel() const { return m_scheduleModel; }
@@ -53,15 +59,15 @@ class SchedulesDisplayController : public ControllerManager {
         void screenshotFailed();
 
 private:
-    std::vector<InformativeSchedule> m_schedules;
+    std::shared_ptr<ScheduleStore> m_schedules = std::make_shared<ScheduleStore>();
+    std::vector<size_t> m_order;  // store position of every displayed schedule, in display order
     ScheduleModel* m_scheduleModel;
     IModel* modelConnection;
     QMap<QString, QString> m_sortKeyMap;
 
-
-    // Track current sort state for optimization
-    QString m_currentSortField;
-    bool m_currentSortAscending = true;
+    // Sorting only orders the schedules ahead of the shown one, more as the user moves on
+    static constexpr size_t SORTED_AHEAD = 64;
+    ScheduleRanking m_ranking;
 };
 
 #endif // SCHEDULES_DISPLAY_H
\ No newline at end of file
@@ -6,9 +6,9 @@ CourseSelectionController::CourseSelectionController(QObject *parent)
         , m_selectedCoursesModel(new CourseModel(this))
         , m_filteredCourseModel(new CourseModel(this))
         , m_blocksModel(new CourseModel(this))
-        , workerThread(nullptr)
-        , validatorThread(nullptr)
         , m_validationInProgress(false)
+        , validatorThread(nullptr)
+        , workerThread(nullptr)
 {
     modelConnection = ModelAccess::getModel();
 }
@@ -17,6 +17,8 @@ CourseSelectionController::~CourseSelectionController() {
 
     cleanupValidatorThread();
 
+    stopActiveGeneration();
+
     if (workerThread) {
         if (workerThread->isRunning()) {
             workerThread->quit();
@@ -358,39 +360,30 @@ void CourseSelectionController::clearAllBlockTimes() {
     emit blockTimesChanged();
 }
 
-Course CourseSelectionController::createSingleBlockTimeCourse() {
-    Course blockCourse;
-    blockCourse.id = 90000; // Fixed ID for the single block course
-    blockCourse.raw_id = "TIME_BLOCKS";
-    blockCourse.name = "Time Block";
-    blockCourse.teacher = "System Generated";
-
-    // Clear all session type vectors
-    blockCourse.Lectures.clear();
-    blockCourse.Tirgulim.clear();
-    blockCourse.labs.clear();
-    blockCourse.blocks.clear();
+void CourseSelectionController::setScheduleFilters(const QVariantMap& filterData) {
+    scheduleFilters = ScheduleFilter::criteriaFromMap(filterData);
+}
 
-    // Create a single group containing all block times
-    Group blockGroup;
-    blockGroup.type = SessionType::BLOCK;
+// The user's block times as sessions, the generation leaves out every option overlapping one
+vector<Session> CourseSelectionController::createBlockedTimes() const {
+    vector<Session> blockedTimes;
 
-    // Add all user block times as sessions to this single group
     for (const auto& blockTime : userBlockTimes) {
         Session blockSession;
         blockSession.day_of_week = getDayNumber(blockTime.day);
-        blockSession.start_time = blockTime.startTime.toStdString();
-        blockSession.end_time = blockTime.endTime.toStdString();
+        if (!TimeUtils::parseMinutes(blockTime.startTime.toStdString(), blockSession.start_minutes) ||
+            !TimeUtils::parseMinutes(blockTime.endTime.toStdString(), blockSession.end_minutes)) {
+            Logger::get().logWarning("Skipping block time with an invalid time: " +
+                                     (blockTime.startTime + " - " + blockTime.endTime).toStdString());
+            continue;
+        }
         blockSession.building_number = "BLOCKED";
         blockSession.room_number = "BLOCK";
 
-        blockGroup.sessions.push_back(blockSession);
+        blockedTimes.push_back(blockSession);
     }
 
-    // Add the group to the course's blocks
-    blockCourse.blocks.push_back(blockGroup);
-
-    return blockCourse;
+    return blockedTimes;
 }
 
 void CourseSelectionController::updateBlockTimesModel() {
@@ -415,8 +408,12 @@ void CourseSelectionController::updateBlockTimesModel() {
 
         Session blockSession;
         blockSession.day_of_week = getDayNumber(blockTime.day);
-        blockSession.start_time = blockTime.startTime.toStdString();
-        blockSession.end_time = blockTime.endTime.toStdString();
+        if (!TimeUtils::parseMinutes(blockTime.startTime.toStdString(), blockSession.start_minutes) ||
+            !TimeUtils::parseMinutes(blockTime.endTime.toStdString(), blockSession.end_minutes)) {
+            Logger::get().logWarning("Skipping block time with an invalid time: " +
+                                     (blockTime.startTime + " - " + blockTime.endTime).toStdString());
+            continue;
+        }
         blockSession.building_number = "BLOCKED";
         blockSession.room_number = "BLOCK";
 
@@ -445,27 +442,47 @@ void CourseSelectionController::generateSchedules() {
         return;
     }
 
-    // Create a worker thread for the operation
-    workerThread = new QThread();
-
-    // Combine selected courses with block times
-    vector<Course> coursesToProcess = selectedCourses;
+    // A previous generation may still be running
+    stopActiveGeneration();
+    scheduleChannel = std::make_shared<ScheduleBatchChannel>(SCHEDULE_CHANNEL_CAPACITY);
+    generationCancellation = std::make_shared<CancellationToken>();
+    streamedScheduleCount = 0;
+    m_expectedScheduleCount = -1;
+    emit scheduleCountChanged();
+    m_generationProgress = -1;
+    emit generationProgressChanged();
 
-    // Add single block times course if there are any block times
-    if (!userBlockTimes.empty()) {
-        Course blockCourse = createSingleBlockTimeCourse();
-        coursesToProcess.push_back(blockCourse);
+    // An aborted generation stops within a few thousand search nodes, its thread is let finish first
+    if (workerThread) {
+        workerThread->quit();
+        workerThread->wait();
     }
 
-    auto* worker = new ScheduleGenerator(modelConnection, coursesToProcess);
+    // Create a worker thread for the operation
+    workerThread = new QThread();
+    QThread* thread = workerThread;
+
+    auto* worker = new ScheduleGenerator(modelConnection, selectedCourses, createBlockedTimes(),
+                                         ScheduleFilter::toConstraints(scheduleFilters), completeSchedules,
+                                         scheduleChannel, generationCancellation);
     worker->moveToThread(workerThread);
+    activeGenerator = worker;
 
     // Connect signals/slots
     connect(workerThread, &QThread::started, worker, &ScheduleGenerator::generateSchedules);
+    connect(worker, &ScheduleGenerator::scheduleCountReady, this, &CourseSelectionController::onScheduleCountReady);
+    connect(worker, &ScheduleGenerator::schedulesBatchReady, this, &CourseSelectionController::onScheduleBatchReady);
+    connect(worker, &ScheduleGenerator::progressChanged, this, &CourseSelectionController::onGenerationProgress);
     connect(worker, &ScheduleGenerator::schedulesGenerated, this, &CourseSelectionController::onSchedulesGenerated);
     connect(worker, &ScheduleGenerator::schedulesGenerated, workerThread, &QThread::quit);
     connect(workerThread, &QThread::finished, worker, &QObject::deleteLater);
     connect(workerThread, &QThread::finished, workerThread, &QObject::deleteLater);
+    connect(workerThread, &QThread::finished, this, [this, thread]() {
+        // The handle is kept until the thread is done, a newer generation may have replaced it already
+        if (workerThread == thread) {
+            workerThread = nullptr;
+        }
+    });
 
     // Start thread before showing overlay
     workerThread->start();
@@ -478,7 +495,8 @@ void CourseSelectionController::generateSchedules() {
 
     // Show loading overlay with a slight delay
     QTimer::singleShot(100, this, [this, engine]() {
-        if (workerThread && workerThread->isRunning()) {
+        // Skip the overlay if the first schedules already arrived
+        if (activeGenerator && streamedScheduleCount == 0) {
             // Get root object
             QObject* rootObject = engine->rootObjects().first();
             if (!rootObject) {
@@ -492,31 +510,139 @@ void CourseSelectionController::generateSchedules() {
     });
 }
 
-void CourseSelectionController::onSchedulesGenerated(vector<InformativeSchedule>* schedules) {
-    // Get the main QML engine
-    auto* engine = qobject_cast<QQmlApplicationEngine*>(getEngine());
-    if (engine && !engine->rootObjects().isEmpty()) {
-        // Hide the loading overlay
-        QObject* rootObject = engine->rootObjects().first();
-        QMetaObject::invokeMethod(rootObject, "showLoadingOverlay",
-                                  Q_ARG(QVariant, QVariant(false)));
+void CourseSelectionController::onScheduleCountReady(qulonglong count) {
+    if (sender() != activeGenerator) {
+        return;
     }
 
-    // Only process if we received schedules (not aborted)
+    m_expectedScheduleCount = static_cast<qint64>(count);
+    emit scheduleCountChanged();
+
+    Logger::get().logInfo(std::to_string(count) + " schedules found for the selected courses");
+    if (count > LARGE_SCHEDULE_COUNT) {
+        Logger::get().logWarning("Generating " + std::to_string(count) + " schedules may take a while");
+    }
+}
+
+void CourseSelectionController::onScheduleBatchReady() {
+    drainScheduleBatches();
+}
+
+void CourseSelectionController::onGenerationProgress(double explored) {
+    if (sender() != activeGenerator) {
+        return;
+    }
+
+    m_generationProgress = explored;
+    emit generationProgressChanged();
+}
+
+// Stops the running generation from the loading overlay, its schedules are dropped
+void CourseSelectionController::abortGeneration() {
+    if (!activeGenerator) {
+        return;
+    }
+
+    Logger::get().logInfo("Schedule generation aborted by the user");
+    stopActiveGeneration();
+
+    // The worker stops within a few thousand search nodes and deletes itself, its result is ignored.
+    // workerThread is kept until the thread finishes, so it can still be waited for.
+    activeGenerator = nullptr;
+    scheduleChannel.reset();
+    generationCancellation.reset();
+
+    hideLoadingOverlay();
+}
+
+// The token ends the search, closing the channel unblocks a generator waiting for room in it
+void CourseSelectionController::stopActiveGeneration() {
+    if (generationCancellation) {
+        generationCancellation->cancel();
+    }
+    if (scheduleChannel) {
+        scheduleChannel->close();
+    }
+}
+
+void CourseSelectionController::onSchedulesGenerated(std::shared_ptr<ScheduleStore> schedules) {
+    // Ignore a generation that was replaced by a newer one
+    if (sender() != activeGenerator) {
+        return;
+    }
+    activeGenerator = nullptr;
+
+    hideLoadingOverlay();
+
+    // Batches queued after the last batch signal was handled
+    drainScheduleBatches();
+
+    // Schedules that were not streamed arrive in one piece
     if (schedules && !schedules->empty()) {
+        showSchedules(*schedules);
+    }
+
+    if (streamedScheduleCount == 0) {
+        emit errorMessage("There are no valid schedules for your selected courses and block times");
+    } else if (schedules && schedules->truncated()) {
+        emit errorMessage(QString("Your selection has more schedules than can be generated at once. "
+                                  "Showing the first %1.").arg(streamedScheduleCount));
+    }
+
+    // The display now holds every schedule of the run; a cut short run cannot be extended
+    completeSchedules.reset();
+    if (schedules && !schedules->truncated() && streamedScheduleCount > 0) {
         auto* schedule_controller =
                 qobject_cast<SchedulesDisplayController*>(findController("schedulesDisplayController"));
+        completeSchedules = schedule_controller->scheduleStore();
+    }
 
-        schedule_controller->loadScheduleData(*schedules);
+    scheduleChannel.reset();
+    generationCancellation.reset();
+}
+
+// Moves every batch waiting on the channel to the schedules display
+void CourseSelectionController::drainScheduleBatches() {
+    if (!scheduleChannel) {
+        return;
+    }
+
+    ScheduleStore batch;
+    while (scheduleChannel->tryPop(batch)) {
+        showSchedules(batch);
+    }
+}
+
+// The first schedules of a generation open the schedules display, later ones are appended to it
+void CourseSelectionController::showSchedules(const ScheduleStore& schedules) {
+    if (schedules.empty()) {
+        return;
+    }
+
+    auto* schedule_controller =
+            qobject_cast<SchedulesDisplayController*>(findController("schedulesDisplayController"));
+
+    if (streamedScheduleCount == 0) {
+        hideLoadingOverlay();
+        schedule_controller->loadScheduleData(schedules);
 
         // Navigate to schedules display screen
         goToScreen(QUrl(QStringLiteral("qrc:/schedules_display.qml")));
     } else {
-        emit errorMessage("There are no valid schedules for your selected courses and block times");
+        schedule_controller->appendScheduleData(schedules);
     }
 
-    // Reset worker thread pointer
-    workerThread = nullptr;
+    streamedScheduleCount += static_cast<int>(schedules.size());
+}
+
+void CourseSelectionController::hideLoadingOverlay() {
+    // Get the main QML engine
+    auto* engine = qobject_cast<QQmlApplicationEngine*>(getEngine());
+    if (engine && !engine->rootObjects().isEmpty()) {
+        QObject* rootObject = engine->rootObjects().first();
+        QMetaObject::invokeMethod(rootObject, "showLoadingOverlay",
+                                  Q_ARG(QVariant, QVariant(false)));
+    }
 }
 
 void CourseSelectionController::toggleCourseSelection(int index) {
@@ -726,14 +852,18 @@ Course CourseSelectionController::createCourseFromData(const QString& courseName
             Logger::get().logInfo("F");
 
 
-            session.start_time = startTime.toStdString();
-            session.end_time = endTime.toStdString();
+            if (!TimeUtils::parseMinutes(startTime.toStdString(), session.start_minutes) ||
+                !TimeUtils::parseMinutes(endTime.toStdString(), session.end_minutes)) {
+                Logger::get().logError("Skipping manual course session with an invalid time: " +
+                                       startTime.toStdString() + " - " + endTime.toStdString());
+                continue;
+            }
             session.building_number = sessionMap["building"].toString().toStdString();
             session.room_number = sessionMap["room"].toString().toStdString();
 
             Logger::get().logInfo("Manual course session created: Day=" + std::to_string(session.day_of_week) +
-                                  ", Start=" + session.start_time +
-                                  ", End=" + session.end_time +
+                                  ", Start=" + TimeUtils::formatMinutes(session.start_minutes) +
+                                  ", End=" + TimeUtils::formatMinutes(session.end_minutes) +
                                   ", Building=" + session.building_number +
                                   ", Room=" + session.room_number);
 
@@ -1,5 +1,4 @@
 #include "schedules_display.h"
-#include <algorithm>
 
 SchedulesDisplayController::SchedulesDisplayController(QObject *parent)
         : ControllerManager(parent),
@@ -8,124 +7,101 @@ SchedulesDisplayController::SchedulesDisplayController(QObject *parent)
     connect(this, &SchedulesDisplayController::schedulesSorted, this, [this]() {
         emit m_scheduleModel->scheduleDataChanged();
     });
+    // Connected before QML binds to the model, so the order is sorted before the new schedule is read
+    connect(m_scheduleModel, &ScheduleModel::currentScheduleIndexChanged, this, [this]() {
+        m_ranking.sortUpTo(m_order, m_scheduleModel->currentScheduleIndex() + SORTED_AHEAD);
+    });
 }
 
 SchedulesDisplayController::~SchedulesDisplayController() {
     modelConnection = nullptr;
 }
 
-void SchedulesDisplayController::loadScheduleData(const std::vector<InformativeSchedule> &schedules) {
-    m_schedules = schedules;
-    m_scheduleModel->loadSchedules(m_schedules);
+void SchedulesDisplayController::loadScheduleData(const ScheduleStore &schedules) {
+    m_schedules = std::make_shared<ScheduleStore>(schedules);
+    m_ranking.assign(*m_schedules);
+    m_ranking.reset(m_order);
+    m_scheduleModel->loadSchedules(m_schedules.get(), &m_order);
+}
+
+void SchedulesDisplayController::appendScheduleData(const ScheduleStore &schedules) {
+    m_schedules->append(schedules);
+
+    // Under a ranking, appended schedules better than the sorted ones move ahead of them
+    bool reordered = m_ranking.append(*m_schedules, m_order);
+    m_scheduleModel->schedulesAppended(reordered);
 }
 
 void SchedulesDisplayController::applySorting(const QVariantMap& sortData) {
-    QString sortField;
-    bool isAscending = true;
+    static const QMap<QString, ScheduleMetric> metricByField = {
+            {"amount_days", ScheduleMetric::AMOUNT_DAYS},
+            {"amount_gaps", ScheduleMetric::AMOUNT_GAPS},
+            {"gaps_time", ScheduleMetric::GAPS_TIME},
+            {"avg_start", ScheduleMetric::AVG_START},
+            {"avg_end", ScheduleMetric::AVG_END}
+    };
+
+    // Every enabled field adds its metric, scaled to its range over the schedules, times its weight
+    // to the score; descending fields subtract it
+    ScheduleRanking::Weights weights{};
+    bool anyEnabled = false;
     for (auto it = sortData.constBegin(); it != sortData.constEnd(); ++it) {
         const QVariantMap criterion = it.value().toMap();
-        if (criterion.value("enabled").toBool()) {
-            sortField = it.key();
-            isAscending = criterion["ascending"].toBool();
-            break;
+        if (!criterion.value("enabled").toBool()) continue;
+
+        if (!metricByField.contains(it.key())) {
+            qWarning() << "Unknown sorting key received:" << it.key();
+            clearSorting();
+            return;
         }
+
+        auto weight = static_cast<float>(criterion.value("weight", 1.0).toDouble());
+        if (!criterion["ascending"].toBool()) weight = -weight;
+        weights[static_cast<int>(metricByField.value(it.key()))] += weight;
+        anyEnabled = true;
     }
 
-    if (sortField.isEmpty()) {
+    if (!anyEnabled) {
         qWarning() << "No sorting field enabled!";
         clearSorting();
         return;
     }
 
-    // Check if we can make it in O(n)
-    if (sortField == m_currentSortField && isAscending != m_currentSortAscending) {
-        std::reverse(m_schedules.begin(), m_schedules.end());
-    }
-    else {
-        if (sortField == "amount_days") {
-            std::vector<std::vector<InformativeSchedule>> buckets(8); // Constant days
-            for (const auto& sched : m_schedules) {
-                if (sched.amount_days >= 1 && sched.amount_days <= 7)
-                    buckets[sched.amount_days].push_back(sched);
-                else
-                    qWarning() << "amount_days out of range:" << sched.amount_days;
-            }
-            m_schedules.clear();
-            if (isAscending) {
-                for (int i = 1; i <= 7; ++i)
-                    m_schedules.insert(m_schedules.end(), buckets[i].begin(), buckets[i].end());
-            } else {
-                for (int i = 7; i >= 1; --i)
-                    m_schedules.insert(m_schedules.end(), buckets[i].begin(), buckets[i].end());
-            }
-        }
-
-        else if (sortField == "amount_gaps") {
-            std::sort(m_schedules.begin(), m_schedules.end(), [isAscending](const InformativeSchedule& a, const InformativeSchedule& b) {
-                return isAscending ? a.amount_gaps < b.amount_gaps : a.amount_gaps > b.amount_gaps;
-            });
-        }
-        else if (sortField == "gaps_time") {
-            std::sort(m_schedules.begin(), m_schedules.end(), [isAscending](const InformativeSchedule& a, const InformativeSchedule& b) {
-                return isAscending ? a.gaps_time < b.gaps_time : a.gaps_time > b.gaps_time;
-            });
-        }
-        else if (sortField == "avg_start") {
-            std::sort(m_schedules.begin(), m_schedules.end(), [isAscending](const InformativeSchedule& a, const InformativeSchedule& b) {
-                return isAscending ? a.avg_start < b.avg_start : a.avg_start > b.avg_start;
-            });
-        }
-        else if (sortField == "avg_end") {
-            std::sort(m_schedules.begin(), m_schedules.end(), [isAscending](const InformativeSchedule& a, const InformativeSchedule& b) {
-                return isAscending ? a.avg_end < b.avg_end : a.avg_end > b.avg_end;
-            });
-        }
-        else {
-            qWarning() << "Unknown sorting key received:" << sortField;
-            clearSorting();
-            return;
-        }
-    }
-
-    m_currentSortField = sortField;
-    m_currentSortAscending = isAscending;
+    m_ranking.rank(weights, m_order, SORTED_AHEAD);
     m_scheduleModel->setCurrentScheduleIndex(0);
-    m_scheduleModel->loadSchedules(m_schedules);
-    emit schedulesSorted(static_cast<int>(m_schedules.size()));
+    m_scheduleModel->loadSchedules(m_schedules.get(), &m_order);
+    emit schedulesSorted(static_cast<int>(m_order.size()));
 }
 
 void SchedulesDisplayController::clearSorting() {
-    // Reset to original order by index
-    std::sort(m_schedules.begin(), m_schedules.end(), [](const InformativeSchedule& a, const InformativeSchedule& b) {
-        return a.index < b.index;
-    });
-
-    m_currentSortField.clear();
-    m_currentSortAscending = true;
+    // Reset to original order, store positions follow the schedule indices
+    m_ranking.reset(m_order);
 
-    m_scheduleModel->loadSchedules(m_schedules);
-    emit schedulesSorted(static_cast<int>(m_schedules.size()));
+    m_scheduleModel->loadSchedules(m_schedules.get(), &m_order);
+    emit schedulesSorted(static_cast<int>(m_order.size()));
 }
 
 void SchedulesDisplayController::saveScheduleAsCSV() {
     int currentIndex = m_scheduleModel->currentScheduleIndex();
-    if (currentIndex >= 0 && currentIndex < static_cast<int>(m_schedules.size())) {
+    if (currentIndex >= 0 && currentIndex < static_cast<int>(m_order.size())) {
         QString fileName = QFileDialog::getSaveFileName(nullptr,
                                                         "Save Schedule as CSV",
                                                         QDir::homePath() + "/" + generateFilename("",
                                                                                                   currentIndex + 1, fileType::CSV),
                                                         "CSV Files (*.csv)");
         if (!fileName.isEmpty()) {
+            InformativeSchedule schedule = m_scheduleModel->scheduleAt(currentIndex);
             modelConnection->executeOperation(ModelOperation::SAVE_SCHEDULE,
-                                              &m_schedules[currentIndex], fileName.toLocal8Bit().constData());
+                                              &schedule, fileName.toLocal8Bit().constData());
         }
     }
 }
 
 void SchedulesDisplayController::printScheduleDirectly() {
     int currentIndex = m_scheduleModel->currentScheduleIndex();
-    if (currentIndex >= 0 && currentIndex < static_cast<int>(m_schedules.size())) {
-        modelConnection->executeOperation(ModelOperation::PRINT_SCHEDULE, &m_schedules[currentIndex], "");
+    if (currentIndex >= 0 && currentIndex < static_cast<int>(m_order.size())) {
+        InformativeSchedule schedule = m_scheduleModel->scheduleAt(currentIndex);
+        modelConnection->executeOperation(ModelOperation::PRINT_SCHEDULE, &schedule, "");
     }
 }
 
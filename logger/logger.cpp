@@ -60,10 +60,17 @@ const vector<LogEntry>& Logger::getLogs() const {
 
 string Logger::getTimeStamp() {
     time_t now = time(nullptr);
-    tm* localTime = localtime(&now);
+
+    // localtime shares one buffer between threads, concurrent generations log at the same time
+    tm localTime{};
+#ifdef _WIN32
+    localtime_s(&localTime, &now);
+#else
+    localtime_r(&now, &localTime);
+#endif
 
     ostringstream oss;
-    oss << put_time(localTime, "%d/%m/%y-%H:%M:%S");
+    oss << put_time(&localTime, "%d/%m/%y-%H:%M:%S");
     return oss.str();
 }
 
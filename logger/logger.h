@@ -8,6 +8,7 @@
 #include <fstream>
 #include <QObject>
 #include <sstream>
+#include <ctime>
 
 using std::string;
 using std::vector;
@@ -2,13 +2,29 @@
 #define INNER_STRUCTS_H
 
 #include "model_interfaces.h"
+#include "WeekMask.h"
+#include "SessionIntervals.h"
 
+// occupancy stays on the fixed 5-minute week: it is filled per course before the grid of a build is known,
+// and the search never reads it. Pairs are checked once on the tightest SlotMask while building the
+// OptionCompatibility table, and the search only tests that table's bits.
 struct CourseSelection {
-    int courseId;
-    const Group* lectureGroup;
-    const Group* tutorialGroup;  // nullptr if none
-    const Group* labGroup;       // nullptr if none
-    const Group* blockGroup;       // nullptr if none
+    int courseId = 0;
+    const Group* lectureGroup = nullptr;
+    const Group* tutorialGroup = nullptr;  // nullptr if none
+    const Group* labGroup = nullptr;       // nullptr if none
+    const Group* blockGroup = nullptr;     // nullptr if none
+    WeekMask occupancy{};                  // slots taken by all sessions of the selection
+    bool occupancyExact = false;           // true when every session maps onto whole slots
+    SessionIntervals intervals{};          // packed sessions for overlap checks, filled only when occupancy is not exact
+};
+
+// Groups meeting at exactly the same times as the groups of one combination. Each list starts with
+// the group the combination uses, nullptr when it has none of that type.
+struct EquivalentGroups {
+    vector<const Group*> lectures;
+    vector<const Group*> tutorials;
+    vector<const Group*> labs;
 };
 
 struct CourseInfo {
@@ -17,6 +17,7 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <memory>
 
 using std::string;
 using std::cout;
@@ -36,13 +37,19 @@ private:
     Model() {}
     static vector<Course> generateCourses(const string& path);
     static vector<string> validateCourses(const vector<Course>& courses);
-    static vector<InformativeSchedule> generateSchedules(const vector<Course>& userInput);
+    static ScheduleStore generateSchedules(const ScheduleGenerationRequest& request);
+    static ScheduleStore generateTopSchedules(const ScheduleGenerationRequest& request);
+    static ScheduleStore generateParetoSchedules(const ScheduleGenerationRequest& request);
+    static bool countSchedules(const ScheduleGenerationRequest& request, size_t& count);
+    static ScheduleStore sampleSchedules(const ScheduleGenerationRequest& request);
+    static void configureBuilder(ScheduleBuilder& builder, const ScheduleGenerationRequest& request);
     static void saveSchedule(const InformativeSchedule& infoSchedule, const string& path);
     static void printSchedule(const InformativeSchedule& infoSchedule);
 
     vector<Course> lastGeneratedCourses;
     vector<string> courseFileErrors;
-    vector<InformativeSchedule> lastGeneratedSchedules;
+
+    inline static const std::chrono::milliseconds COUNT_TIME_LIMIT{2000};
 };
 
 inline IModel* getModel() {
@@ -34,6 +34,7 @@
 #endif
 
 #include "model_interfaces.h"
+#include "TimeUtils.h"
 
 using namespace std;
 using namespace OpenXLSX;
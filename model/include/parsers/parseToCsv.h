@@ -14,9 +14,6 @@
 #include <sstream>
 #include <iomanip>
 
-// Helper function to convert time string to hour integer
-int getHourFromTimeString(const std::string& timeStr);
-
 // Function to detect if text contains Hebrew characters
 bool containsHebrew(const std::string& text);
 
@@ -2,6 +2,7 @@
 #define VALIDATE_COURSES_H
 
 #include "model_interfaces.h"
+#include "SessionIntervals.h"
 #include "logger.h"
 
 #include <vector>
@@ -11,19 +12,26 @@
 using namespace std;
 
 struct OptimizedSlot {
-  string start_time;
-  string end_time;
   string course_id;
   int start_minutes;
   int end_minutes;
 
   OptimizedSlot(const string& start, const string& end, const string& id);
 
+  // Takes the minutes parsed with the session
+  OptimizedSlot(const Session& session, const string& id);
+
   bool overlapsWith(const OptimizedSlot& other) const;
 };
 
 using RoomKey = string;
-using DaySlots = vector<OptimizedSlot>;
+
+// Slots of one room on one day, with their times packed for checking a new slot against all of them
+struct DaySlots {
+  vector<OptimizedSlot> occupied;
+  SessionIntervals intervals;
+};
+
 using RoomSchedule = unordered_map<int, DaySlots>;
 using BuildingSchedule = unordered_map<RoomKey, RoomSchedule>;
 
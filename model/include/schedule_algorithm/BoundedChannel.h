@@ -0,0 +1,80 @@
+#ifndef BOUNDED_CHANNEL_H
+#define BOUNDED_CHANNEL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+// First-in first-out hand-off between a producer and a consumer thread.
+// A producer that gets ahead of its consumer waits once capacity items are queued,
+// so a fast search cannot pile up more results than the receiver keeps up with.
+template <typename T>
+class BoundedChannel {
+public:
+    explicit BoundedChannel(size_t capacity) : capacity(capacity == 0 ? 1 : capacity) {}
+
+    // Waits for room, returns false without queueing once the channel is closed
+    bool push(T item) {
+        std::unique_lock<std::mutex> guard(lock);
+        notFull.wait(guard, [this]() { return closed || items.size() < capacity; });
+        if (closed) return false;
+
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Takes the oldest item if there is one, never waits
+    bool tryPop(T& item) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (items.empty()) return false;
+
+        takeFront(item);
+        return true;
+    }
+
+    // Waits for an item, returns false once the channel is closed and drained
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> guard(lock);
+        notEmpty.wait(guard, [this]() { return closed || !items.empty(); });
+        if (items.empty()) return false;
+
+        takeFront(item);
+        return true;
+    }
+
+    // Rejects further pushes and wakes every waiting thread, queued items can still be popped
+    void close() {
+        std::lock_guard<std::mutex> guard(lock);
+        closed = true;
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+
+    bool isClosed() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return closed;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return items.size();
+    }
+
+private:
+    const size_t capacity;
+    mutable std::mutex lock;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    std::deque<T> items;
+    bool closed = false;
+
+    void takeFront(T& item) {
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+    }
+};
+
+#endif //BOUNDED_CHANNEL_H
@@ -0,0 +1,41 @@
+#ifndef CONSTRAINT_BOUND_H
+#define CONSTRAINT_BOUND_H
+
+#include "model_interfaces.h"
+#include "inner_structs.h"
+#include "IncrementalMetrics.h"
+#include "ObjectiveBound.h"
+#include "ScheduleStore.h"
+#include "WeekMask.h"
+
+#include <vector>
+
+// Checks schedules against ScheduleConstraints and tells when no completion of a partial schedule
+// can meet them. Only limits a later course cannot undo are used to cut a branch: days only add up,
+// and a gap no remaining session can fall into stays. The average limits use ObjectiveBound.
+class ConstraintBound {
+public:
+    ConstraintBound(const vector<vector<CourseSelection>>& allOptions, const ScheduleConstraints& constraints);
+
+    // True when a complete schedule meets every limit
+    bool allows(const ScheduleMetrics& metrics, const IncrementalMetrics& current) const;
+
+    // False when no completion of the chosen options, given per course with -1 for a course still open, can meet them
+    bool reachable(const vector<int>& chosenOptions, const IncrementalMetrics& current) const;
+
+    // Sessions covering every day up to the earliest start, an option overlapping them starts too early.
+    // Empty without an earliest start.
+    static vector<Session> earlyTimes(const ScheduleConstraints& constraints);
+
+private:
+    ScheduleConstraints constraints;
+    ObjectiveBound latestStart;  // highest average start any completion can reach
+    ObjectiveBound earliestEnd;  // lowest average end any completion can reach
+
+    vector<WeekMask> reachableSlots;  // every slot any option of the course may take
+    vector<char> exact;               // reachableSlots of the course covers every session
+
+    bool gapsReachable(const vector<int>& chosenOptions, const IncrementalMetrics& current) const;
+};
+
+#endif //CONSTRAINT_BOUND_H
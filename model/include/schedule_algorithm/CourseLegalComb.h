@@ -5,12 +5,28 @@
 #include "model_interfaces.h"
 #include "inner_structs.h"
 #include "TimeUtils.h"
+#include "getSession.h"
 #include "logger.h"
 
 class CourseLegalComb {
 public:
     static vector<CourseSelection> generate(const Course& course) ;
+
+    // Like generate, but groups of one type with the same session times are combined only once.
+    // equivalents[i] receives the groups combination i can be switched to without changing its times.
+    static vector<CourseSelection> generateDistinct(const Course& course, vector<EquivalentGroups>& equivalents) ;
+
+    // Fills the occupancy of a selection, and its packed sessions when the occupancy is not exact
+    static void computeOccupancy(CourseSelection& selection) ;
 private:
-    static bool hasGroupConflict(const Group* group1, const Group* group2) ;
+    // Each class is a list of interchangeable groups, the first one is used in the combinations
+    static vector<CourseSelection> combine(const Course& course,
+                                           const vector<vector<const Group*>>& lectures,
+                                           const vector<vector<const Group*>>& tutorials,
+                                           const vector<vector<const Group*>>& labs,
+                                           vector<EquivalentGroups>* equivalents) ;
+    static vector<vector<const Group*>> groupClasses(const vector<Group>& groups, bool byTimes) ;
+    static vector<SessionIntervals> packClasses(const vector<vector<const Group*>>& classes) ;
+    static bool hasGroupConflict(const SessionIntervals& group1, const SessionIntervals& group2) ;
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef INCREMENTAL_METRICS_H
+#define INCREMENTAL_METRICS_H
+
+#include "model_interfaces.h"
+#include "inner_structs.h"
+#include "ScheduleStore.h"
+#include "getSession.h"
+#include "TimeUtils.h"
+#include "WeekMask.h"
+
+#include <array>
+#include <vector>
+
+// Session minutes of every option, parsed once per generation and shared by every search thread
+class OptionMinutes {
+public:
+    // A session of an option; course and order keep sessions with the same start in schedule order
+    struct Interval {
+        int day;    // day_of_week - 1
+        int start;
+        int end;
+        int course;
+        int order;  // position among the sessions of the option
+    };
+
+    explicit OptionMinutes(const vector<vector<CourseSelection>>& allOptions);
+
+    const vector<Interval>& sessions(int course, int option) const { return options[course][option]; }
+
+    // False when a session of the option has no time
+    bool valid(int course, int option) const { return parsed[course][option]; }
+
+private:
+    vector<vector<vector<Interval>>> options;
+    vector<vector<char>> parsed;
+};
+
+// Per-day sessions of the options chosen so far, with the metrics they give kept up to date.
+// Options are added and removed as the search goes down and back up, so a complete schedule's
+// metrics are read off without looking at its sessions again.
+class IncrementalMetrics {
+public:
+    IncrementalMetrics() = default;
+    explicit IncrementalMetrics(const OptionMinutes* minutes) : minutes(minutes) {}
+
+    void add(int course, int option);
+    void remove(int course, int option);
+
+    // Same values as calculating them over the chosen sessions
+    ScheduleMetrics metrics() const;
+
+    int activeDays() const { return totalDays; }
+    int gaps() const { return totalGaps; }
+    int gapsTime() const { return totalGapTime; }
+
+    // Longest gap of any day, gaps start at MIN_GAP_MINUTES
+    int longestGap() const;
+
+    // Chosen sessions of a day (0 = day_of_week 1), by start
+    const vector<OptionMinutes::Interval>& daySessions(int day) const { return days[day].items; }
+
+private:
+    // Sessions of one day, by start and then schedule order
+    struct Day {
+        vector<OptionMinutes::Interval> items;
+        int gaps = 0;
+        int gapTime = 0;
+        int longestGap = 0;
+    };
+
+    const OptionMinutes* minutes = nullptr;
+    array<Day, WeekMask::DAYS> days;
+    int totalDays = 0;
+    int totalGaps = 0;
+    int totalGapTime = 0;
+    int totalStart = 0;
+    int totalEnd = 0;
+    int unparsed = 0;  // chosen options with a session without a time
+
+    // Adds (sign 1) or takes away (sign -1) what the day adds to the totals
+    void count(Day& day, int sign);
+};
+
+#endif //INCREMENTAL_METRICS_H
@@ -0,0 +1,69 @@
+#ifndef OBJECTIVE_BOUND_H
+#define OBJECTIVE_BOUND_H
+
+#include "model_interfaces.h"
+#include "inner_structs.h"
+#include "ScheduleStore.h"
+#include "getSession.h"
+#include "TimeUtils.h"
+#include "WeekMask.h"
+
+#include <array>
+#include <climits>
+#include <vector>
+
+// Scores schedules for an objective and bounds the best score a partial schedule can still reach.
+// Scores are lower-is-better: ascending objectives score the metric, descending ones its negation.
+class ObjectiveBound {
+public:
+    ObjectiveBound(const vector<vector<CourseSelection>>& allOptions, const ScheduleObjective& objective);
+
+    int score(const ScheduleMetrics& metrics) const;
+
+    // False when the objective has no bound worth computing, e.g. the most gaps
+    bool canPrune() const;
+
+    // Lowest score of any completion of the chosen options, given per course with -1 for a course still open.
+    // Returns INT_MIN when nothing useful can be said.
+    int lowerBound(const vector<int>& chosenOptions) const;
+
+private:
+    // Earliest and latest session start and end of a day, over every option of a course
+    struct DayReach {
+        int earliestStart = INT_MAX;
+        int latestStart = INT_MIN;
+        int earliestEnd = INT_MAX;
+        int latestEnd = INT_MIN;
+
+        bool reachable() const { return earliestStart != INT_MAX; }
+        void merge(const DayReach& other);
+    };
+
+    // A session in minutes, parsed once
+    struct SessionMinutes {
+        int day;  // 0 = Sunday
+        int start;
+        int end;
+    };
+
+    struct CourseReach {
+        array<DayReach, WeekMask::DAYS> days;
+        vector<vector<SessionMinutes>> optionSessions;
+        WeekMask reachableSlots;  // every slot any option of the course may take
+        bool exact = true;        // reachableSlots covers every session
+        bool valid = true;        // every session has a time
+    };
+
+    ScheduleObjective objective;
+    vector<CourseReach> courses;
+
+    int gapsBound(const array<vector<pair<int, int>>, WeekMask::DAYS>& days,
+                  const WeekMask& remainingSlots) const;
+
+    int averageBound(const array<vector<pair<int, int>>, WeekMask::DAYS>& days,
+                     const array<DayReach, WeekMask::DAYS>& remaining) const;
+
+    static int boundedMean(int sum, int count, vector<int>& optional, bool lowest);
+};
+
+#endif //OBJECTIVE_BOUND_H
@@ -0,0 +1,112 @@
+#ifndef OPTION_COMPATIBILITY_H
+#define OPTION_COMPATIBILITY_H
+
+#include "inner_structs.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Pairwise compatibility of course options, computed once before the search.
+// Every option of every course holds one bitset per other course, with a bit set
+// for each option of that course it does not conflict with.
+class OptionCompatibility {
+public:
+    using ConflictCheck = bool (*)(const CourseSelection&, const CourseSelection&);
+
+    OptionCompatibility(const vector<vector<CourseSelection>>& allOptions, ConflictCheck hasConflict);
+
+    // Same table for counts[course] options per course, from conflicts(course, option, otherCourse, otherOption)
+    template <typename Conflicts>
+    OptionCompatibility(const vector<int>& counts, Conflicts conflicts) {
+        layout(counts);
+
+        for (int i = 0; i < courseCount(); i++) {
+            for (int j = i + 1; j < courseCount(); j++) {
+                for (int a = 0; a < optionCounts[i]; a++) {
+                    for (int b = 0; b < optionCounts[j]; b++) {
+                        if (conflicts(i, a, j, b)) continue;
+
+                        row(i, a, j)[b / 64] |= 1ULL << (b % 64);
+                        row(j, b, i)[a / 64] |= 1ULL << (a % 64);
+                    }
+                }
+            }
+        }
+    }
+
+    int courseCount() const { return static_cast<int>(optionCounts.size()); }
+    int optionCount(int course) const { return optionCounts[course]; }
+    int wordCount(int course) const { return wordCounts[course]; }
+    size_t memoryBytes() const { return bits.size() * sizeof(uint64_t); }
+
+    // Options of otherCourse compatible with the given option of course, wordCount(otherCourse) words long
+    const uint64_t* compatibleOptions(int course, int option, int otherCourse) const {
+        return &bits[(optionOffsets[course] + option) * rowWords + courseOffsets[otherCourse]];
+    }
+
+    // Fills target with every option of a course
+    void fillAll(int course, vector<uint64_t>& target) const;
+
+    // Remaining options of every course side by side, domainWords() long; a course's options start at domainOffset(course)
+    size_t domainWords() const { return rowWords; }
+    size_t domainOffset(int course) const { return courseOffsets[course]; }
+
+    // Fills domains with every option of every course
+    void fillDomains(vector<uint64_t>& domains) const;
+
+    // Copies the domains of the given courses into target, keeping only the options compatible
+    // with the given option. Returns false as soon as one of those courses has none left.
+    bool narrowDomains(int course, int option, const vector<int>& courses,
+                       const uint64_t* domains, uint64_t* target) const;
+
+    // Number of options of a course left in domains
+    int remainingOptions(int course, const uint64_t* domains) const;
+
+    static void intersect(uint64_t* target, const uint64_t* source, int words) {
+        for (int i = 0; i < words; i++) {
+            target[i] &= source[i];
+        }
+    }
+
+    static int bitCount(uint64_t word) {
+#ifdef _MSC_VER
+        return static_cast<int>(__popcnt64(word));
+#else
+        return __builtin_popcountll(word);
+#endif
+    }
+
+    static int lowestSetBit(uint64_t word) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
+
+private:
+    vector<int> optionCounts;
+    vector<int> wordCounts;
+    vector<size_t> optionOffsets;  // row of the first option of each course
+    vector<size_t> courseOffsets;  // word offset of each course's bitset inside a row
+    size_t rowWords = 0;
+    vector<uint64_t> bits;
+
+    // Sizes the table for the given option counts, with no pair compatible yet
+    void layout(const vector<int>& counts);
+
+    static vector<int> countOptions(const vector<vector<CourseSelection>>& allOptions);
+
+    uint64_t* row(int course, int option, int otherCourse) {
+        return &bits[(optionOffsets[course] + option) * rowWords + courseOffsets[otherCourse]];
+    }
+};
+
+#endif //OPTION_COMPATIBILITY_H
@@ -3,45 +3,385 @@
 
 #include "model_interfaces.h"
 #include "CourseLegalComb.h"
+#include "ObjectiveBound.h"
+#include "IncrementalMetrics.h"
+#include "ConstraintBound.h"
+#include "OptionCompatibility.h"
+#include "ScheduleStore.h"
+#include "WorkStealingPool.h"
 #include "inner_structs.h"
 #include "getSession.h"
 #include "TimeUtils.h"
 #include "logger.h"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
+#include <atomic>
+#include <deque>
+#include <chrono>
+#include <array>
+#include <climits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <tuple>
 #include <vector>
 #include <map>
 
+// How one build, rebuild, count or sample ended, handed back with its result
+struct BuildOutcome {
+    bool truncated = false;  // stopped at its budget
+    bool stopped = false;    // stopped by the batch receiver or the cancellation token
+    size_t delivered = 0;    // schedules handed to the batch callback
+    bool reused = false;     // a rebuildStore extending the previous schedules, not a search
+};
+
+// Settings are made before building; each build, rebuild or count then keeps its own state, so one
+// builder can run several of them at once on different threads. Catalogs are only read once built,
+// results of concurrent builds share nothing else. Every build tells how it ended through outcome,
+// when one is passed.
+// The shared search, budgets and streaming are in ScheduleBuilder.cpp; catalog and compatibility building,
+// rebuilds, top-K, Pareto fronts, and counts with samples each have their own ScheduleBuilder*.cpp.
 class ScheduleBuilder {
 public:
-    vector<InformativeSchedule> build(const vector<Course>& courses);
+    // Finds every valid schedule, kept as option indices until a schedule is materialized
+    ScheduleStore buildStore(const vector<Course>& courses, BuildOutcome* outcome = nullptr) const;
+
+    // Same result and order as buildStore, extending previous instead of searching when courses only adds one course to it
+    ScheduleStore rebuildStore(const ScheduleStore& previous, const vector<Course>& courses,
+                               BuildOutcome* outcome = nullptr) const;
+
+    // Same search, with every schedule materialized
+    vector<InformativeSchedule> build(const vector<Course>& courses) const;
+
+    // Keeps only the k best schedules by objective, best first, ties in search order.
+    // Subtrees whose optimistic bound cannot beat the current k-th best are skipped.
+    ScheduleStore buildTopK(const vector<Course>& courses, const ScheduleObjective& objective, size_t k,
+                            BuildOutcome* outcome = nullptr) const;
+
+    // Keeps only the Pareto-optimal schedules over the objectives, those no other schedule matches or beats on
+    // every objective while beating it on one. Schedules scoring the same on all of them are kept once, the
+    // first in search order. Sorted by the first objective, then the next ones. Subtrees whose optimistic
+    // scores a kept schedule already matches are skipped.
+    ScheduleStore buildParetoFront(const vector<Course>& courses, const vector<ScheduleObjective>& objectives,
+                                   BuildOutcome* outcome = nullptr) const;
+
+    // Number of valid schedules, counted without storing or materializing any of them.
+    // Under constraints on the metrics every subtree is walked, the same subtree may meet them or not.
+    size_t countSchedules(const vector<Course>& courses, BuildOutcome* outcome = nullptr) const;
+
+    // Draws count different schedules uniformly at random from the ones countSchedules counts, all of them
+    // when there are no more. The same seed draws the same schedules, returned in the order the search meets them.
+    // Each one is found by walking down the counted search tree, so nothing else is enumerated.
+    // Of the constraints only the earliest start can be applied, a sample under any other returns none.
+    ScheduleStore sampleSchedules(const vector<Course>& courses, size_t count, uint64_t seed,
+                                  BuildOutcome* outcome = nullptr) const;
+
+    // Number of threads the search is split across, 1 keeps it on the calling thread
+    void setThreadCount(int count);
+
+    // Streams schedules to callback in search order while the search runs; build then returns none.
+    // A batchSize of 0 keeps the default. Concurrent builds call it concurrently.
+    void setBatchCallback(ScheduleBatchCallback callback, size_t batchSize = 0);
+
+    // Times the following builds and counts keep free; options overlapping them are dropped before searching
+    void setBlockedTimes(const vector<Session>& blocked);
+
+    // Limits every schedule of the following builds has to meet, branches that cannot meet them are cut.
+    // Counts apply them too, samples only take the earliest start.
+    void setConstraints(const ScheduleConstraints& limits);
+
+    // Whether the following builds and counts keep one option per distinct set of session times per course.
+    // Schedules then stand for every schedule with the same week, see ScheduleStore::variantCount.
+    void setCollapseSameTimeOptions(bool collapse);
+
+    // Limits of the following builds and counts. One that reaches a limit keeps what it found so far.
+    void setBudget(const GenerationBudget& generationBudget);
+
+    // Stops the following builds and counts once token is cancelled
+    void setCancellation(shared_ptr<const CancellationToken> token);
+
+    // Reports how much of the search tree the following builds explored, throttled to PROGRESS_INTERVAL
+    void setProgressCallback(ScheduleProgressCallback callback);
 
 private:
-    static unordered_map<int, CourseInfo> courseInfoMap;
+    // Tasks handed to the pool per thread, so stealing can even out unbalanced subtrees
+    static constexpr int TASKS_PER_THREAD = 4;
+
+    static constexpr size_t DEFAULT_BATCH_SIZE = 64;
+
+    // Search nodes between two looks at the clock, the cancellation token and the progress
+    static constexpr size_t CHECKPOINT_INTERVAL = 1024;
+
+    // Shortest time between two progress reports
+    static constexpr chrono::milliseconds PROGRESS_INTERVAL{100};
+
+    // Search levels whose branches are counted towards the progress
+    static constexpr int PROGRESS_DEPTH = 2;
+
+    // Counted subtrees remembered at most, bounds the memory of a count
+    static constexpr size_t MAX_COUNT_MEMO_ENTRIES = 1 << 18;
+
+    // A schedule of the Pareto front
+    struct ParetoPoint {
+        vector<int> scores;                // one per objective, lower is better
+        pair<size_t, size_t> searchOrder;  // task and sequence inside it
+        vector<int> options;
+        ScheduleMetrics metrics;
+    };
+
+    // State of one depth-first search, every thread owns its own
+    struct SearchState {
+        // domainsByLevel[depth] holds the options of the open courses that fit every option chosen so far
+        vector<vector<uint64_t>> domainsByLevel;
+        vector<int> chosenOptions;                // option of every course in course order, -1 while open
+        IncrementalMetrics metrics;               // metrics of the chosen options, updated as they change
+        vector<int> openCourses;                  // courses without an option yet, ascending
+        ScheduleStore results;
+        size_t flushAt = SIZE_MAX;  // results are handed to the batch callback once this many are held
+        size_t task = 0;            // search order of complete schedules, used to break ties
+        size_t sequence = 0;
+        size_t found = 0;           // schedules stored by this search, delivered ones included
+        size_t resultCap = SIZE_MAX;  // schedules this search may store, its part of the result limit
+        size_t foundAtTrim = 0;     // found when this search last trimmed the finished parallel tasks
+        bool limitEndsSearch = true;  // reaching the result limit ends the build, not only this search
+        bool full = false;          // this search reached the result limit
+        size_t visited = 0;         // nodes since the search started, paces the checkpoints
+        bool tracksProgress = false;  // this search reports its progress at checkpoints
+        double explored = 0;        // fraction of the tree behind the branches finished so far
+        double branchShare = 1;     // fraction of the tree below the current node
+        vector<ParetoPoint> paretoFront;  // copy of the shared front, taken again once it changed
+        size_t paretoVersion = SIZE_MAX;
+    };
+
+    // Open courses and their remaining options, which is all a subtree's count depends on
+    struct DomainsHash {
+        size_t operator()(const vector<uint64_t>& key) const;
+    };
+    using CountMemo = unordered_map<vector<uint64_t>, size_t, DomainsHash>;
+
+    struct RankedSchedule {
+        int score;
+        pair<size_t, size_t> searchOrder;  // task and sequence inside it
+        vector<int> options;
+        ScheduleMetrics metrics;
+
+        // Better schedules sort first, equal scores keep the search order
+        bool operator<(const RankedSchedule& other) const {
+            return score != other.score ? score < other.score : searchOrder < other.searchOrder;
+        }
+    };
+
+    // Best schedules found so far as a heap with the worst on top, shared by all search threads
+    struct TopKState {
+        size_t k;
+        ObjectiveBound bound;
+        mutex lock;
+        vector<RankedSchedule> heap;
+        atomic<int> worstScore{INT_MAX};  // score a schedule has to match once the heap is full
+
+        TopKState(size_t k, ObjectiveBound bound) : k(k), bound(std::move(bound)) {}
+    };
+
+    // Schedules no schedule found so far covers, shared by all search threads
+    struct ParetoState {
+        vector<ObjectiveBound> bounds;  // one per objective
+        bool canPrune = false;          // at least one objective can bound a partial schedule
+        mutex lock;
+        vector<ParetoPoint> front;
+        atomic<size_t> version{0};      // changes with the front
+
+        explicit ParetoState(vector<ObjectiveBound> bounds);
+    };
+
+    // Schedules of the parallel tasks of a search, merged in task order once every earlier task finished
+    struct TaskBuffers {
+        vector<ScheduleStore> buffers;  // under deliveryLock
+        vector<char> finished;          // under deliveryLock
+        size_t nextToMerge = 0;         // under deliveryLock
+        vector<atomic<size_t>> found;   // schedules each task kept so far, merged ones included
+
+        TaskBuffers(size_t taskCount, const shared_ptr<const ScheduleCatalog>& catalog)
+                : buffers(taskCount, ScheduleStore(catalog)), finished(taskCount, 0), found(taskCount) {}
+    };
+
+    // State of one build or count, shared by its search threads
+    struct BuildRun {
+        unique_ptr<TopKState> topK;
+        unique_ptr<ParetoState> pareto;
+        unique_ptr<ConstraintBound> constraintBound;  // set while a search applies constraints
+        unique_ptr<TaskBuffers> tasks;                // set while the search runs in parallel
+        bool countOnly = false;     // complete schedules are only counted, by a count under constraints
+        bool reusedPrevious = false;  // rebuildStore extended the previous schedules
+
+        size_t deliveredCount = 0;
+        atomic<bool> stopRequested{false};
+        mutex deliveryLock;
+        deque<ScheduleStore> pendingBatches;  // numbered batches the callback has not had yet, under deliveryLock
+        mutex sendLock;                       // held by the one thread passing batches to the callback
+
+        atomic<chrono::steady_clock::rep> lastProgressReport{0};
+        double exploredTasks = 0;  // share of the tree behind the finished parallel tasks, under deliveryLock
+
+        size_t resultLimit = SIZE_MAX;
+        chrono::steady_clock::time_point deadline;
+        atomic<bool> budgetExhausted{false};
+    };
+
+    int threadCount = 1;
+
+    ScheduleBatchCallback batchCallback;
+    size_t batchSize = DEFAULT_BATCH_SIZE;
+
+    shared_ptr<const CancellationToken> cancellation;
+    ScheduleProgressCallback progressCallback;
+
+    vector<Session> blockedTimes;
+    bool collapseSameTimes = false;
+    ScheduleConstraints constraints;
+
+    GenerationBudget budget;
+
+    shared_ptr<ScheduleCatalog> buildCatalog(BuildRun& run, const vector<Course>& courses) const;
+
+    static void collapseSameTimeOptions(ScheduleCatalog& catalog,
+                                        const vector<vector<EquivalentGroups>>& equivalents);
+
+    static vector<CourseSelection> expandEquivalentGroups(const CourseSelection& option,
+                                                          const EquivalentGroups& equivalent);
+
+    void search(BuildRun& run, const OptionCompatibility& compatibility, ScheduleStore& results) const;
+
+    void offerTopK(BuildRun& run, const SearchState& state, const ScheduleMetrics& metrics) const;
+
+    void offerPareto(BuildRun& run, const SearchState& state, const ScheduleMetrics& metrics) const;
+
+    // True when a schedule found already covers every completion of the options chosen in state
+    static bool paretoCovered(BuildRun& run, SearchState& state);
+
+    // True when point scores at most scores on every objective, and less on one or comes first in search order
+    static bool covers(const ParetoPoint& point, const vector<int>& scores, const pair<size_t, size_t>& searchOrder);
+
+    void searchInParallel(
+            BuildRun& run,
+            const vector<vector<CourseSelection>>& allOptions,
+            const OptionCompatibility& compatibility,
+            const OptionMinutes& minutes,
+            ScheduleStore& results) const;
+
+    static void prepareSearchState(const OptionCompatibility& compatibility, SearchState& state);
+
+    void appendInOrder(BuildRun& run, const ScheduleStore& buffer, ScheduleStore& results) const;
+
+    // Schedules the parallel tasks before task kept so far, a lower bound of the schedules ahead of its own
+    static size_t schedulesBefore(const BuildRun& run, size_t task);
+
+    // Shrinks a parallel task's part of the result limit to what the earlier tasks left; false when it has to stop
+    static bool limitTask(BuildRun& run, SearchState& state);
+
+    // Drops schedules of finished, unmerged tasks the earlier tasks already push past the result limit.
+    // Called under deliveryLock.
+    static void trimFinishedTasks(BuildRun& run);
+
+    void startBudget(BuildRun& run, size_t bytesPerSchedule) const;
+
+    bool checkpoint(BuildRun& run, SearchState& state) const;
+
+    bool checkCancellation(BuildRun& run) const;
+
+    void reportProgress(BuildRun& run, double explored) const;
+
+    void finishProgress(BuildRun& run) const;
+
+    void exhaustBudget(BuildRun& run, const string& limit) const;
+
+    void deliverBatch(BuildRun& run, ScheduleStore& schedules) const;
+    void queueBatch(BuildRun& run, ScheduleStore& schedules) const;
+    void sendBatches(BuildRun& run) const;
+
+    static void recordOutcome(const BuildRun& run, BuildOutcome* outcome);
+
+    static void collectPrefixes(
+            int depth,
+            int splitDepth,
+            const OptionCompatibility& compatibility,
+            SearchState& state,
+            vector<vector<int>>& prefixes,
+            vector<double>& shares);
+
+    static size_t selectCourse(
+            const OptionCompatibility& compatibility,
+            const vector<int>& openCourses,
+            const vector<uint64_t>& domains);
+
+    void completeSchedule(BuildRun& run, SearchState& state) const;
 
     void backtrack(
-            int index,
+            BuildRun& run,
+            int depth,
             const vector<vector<CourseSelection>>& allOptions,
-            vector<CourseSelection>& current,
-            vector<InformativeSchedule>& results);
+            const OptionCompatibility& compatibility,
+            SearchState& state) const;
 
-    static bool hasConflict(const CourseSelection& a, const CourseSelection& b) ;
+    size_t countCompletions(
+            BuildRun& run,
+            int depth,
+            const OptionCompatibility& compatibility,
+            SearchState& state,
+            CountMemo& memo) const;
+
+    // Sets state.chosenOptions to the schedule at rank in search order; false when the budget ran out on the way
+    bool unrankSchedule(
+            BuildRun& run,
+            size_t rank,
+            const OptionCompatibility& compatibility,
+            SearchState& state,
+            CountMemo& memo) const;
+
+    // count different ranks below total, ascending, drawn with Floyd's algorithm
+    static vector<size_t> sampleRanks(size_t total, size_t count, uint64_t seed);
+
+    // Positions of schedules sorted into the order a search over compatibility finds them
+    static vector<size_t> orderLikeSearch(const OptionCompatibility& compatibility, const ScheduleStore& schedules);
+
+    static void orderLevel(
+            const OptionCompatibility& compatibility,
+            const vector<uint32_t>& options,
+            int depth,
+            vector<size_t>::iterator first,
+            vector<size_t>::iterator last,
+            SearchState& state);
 
-    InformativeSchedule convertToInformativeSchedule(const vector<CourseSelection>& selections, int index) const;
+    static bool matchPreviousCourses(
+            const vector<Course>& previousCourses,
+            const vector<Course>& courses,
+            vector<int>& previousCourse,
+            int& added);
+
+    static bool sameCourse(const Course& a, const Course& b);
+
+    static bool sameSessions(const vector<Session>& a, const vector<Session>& b);
+
+    static bool hasConflict(const CourseSelection& a, const CourseSelection& b) ;
 
-    static void processGroupSessions(const CourseSelection& selection,
-                              const Group* group,
-                              const string& sessionType,
-                              map<int, vector<ScheduleItem>>& daySchedules) ;
+    // Compatibility table of the options, with conflicts checked on the coarsest slot grid and fewest days
+    // their sessions fit, so each mask takes as few words as the catalog allows
+    static OptionCompatibility buildCompatibility(const vector<vector<CourseSelection>>& options,
+                                                  const CancellationToken* cancellation = nullptr);
 
-    static string getCourseNameById(int courseId) ;
+    OptionCompatibility buildCompatibility(BuildRun& run, const vector<vector<CourseSelection>>& options) const;
 
-    static string getCourseRawIdById(int courseId) ;
+    template <int Days>
+    static OptionCompatibility compatibilityForDays(int slotMinutes, const vector<vector<CourseSelection>>& options,
+                                                    const CancellationToken* cancellation);
 
-    static void buildCourseInfoMap(const vector<Course>& courses);
+    template <typename Mask>
+    static OptionCompatibility compatibilityOn(const vector<vector<CourseSelection>>& options,
+                                               const CancellationToken* cancellation);
 
-    static void calculateScheduleMetrics(InformativeSchedule& schedule) ;
+    static void buildCourseInfoMap(const vector<Course>& courses, unordered_map<int, CourseInfo>& courseInfo);
 };
 
 #endif // SCHEDULE_BUILDER_H
\ No newline at end of file
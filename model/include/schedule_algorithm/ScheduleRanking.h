@@ -0,0 +1,59 @@
+#ifndef SCHEDULE_RANKING_H
+#define SCHEDULE_RANKING_H
+
+#include "model_interfaces.h"
+#include "ScheduleStore.h"
+
+#include <array>
+#include <vector>
+
+// Orders the schedules of a store by a weighted sum of their metrics, lowest first.
+// Each metric is scaled to its min-max range over the store before weighting, so minutes and
+// day counts weigh the same at the same weight.
+// Metrics are packed one array per metric, so scoring is a single pass the compiler vectorizes,
+// and only the displayed part of the order is sorted; the rest is sorted as it is reached.
+class ScheduleRanking {
+public:
+    static constexpr int METRIC_COUNT = 5;
+
+    // One weight per ScheduleMetric, in its order. A negative weight prefers higher values, zero ignores the metric.
+    using Weights = std::array<float, METRIC_COUNT>;
+
+    // Packs the metrics of every schedule, dropping any ranking
+    void assign(const ScheduleStore& schedules);
+
+    // Packs the schedules of the store past the ones already packed and adds their positions to order.
+    // Under a ranking they are scored, and those beating the sorted part of the order move into it;
+    // when they widen a metric's range every schedule is scored again and the sorted part redone.
+    // Returns whether the sorted part changed.
+    bool append(const ScheduleStore& schedules, std::vector<size_t>& order);
+
+    size_t size() const { return scores.size(); }
+    bool ranked() const { return isRanked; }
+    size_t sortedCount() const { return sorted; }
+
+    // Scores every schedule and resets order to store positions sorted up to count, ties by position
+    void rank(const Weights& weights, std::vector<size_t>& order, size_t count);
+
+    // Sorts order up to count, keeping the part already sorted. Does nothing when not ranked.
+    void sortUpTo(std::vector<size_t>& order, size_t count);
+
+    // Drops the ranking, order goes back to store positions
+    void reset(std::vector<size_t>& order);
+
+private:
+    std::array<std::vector<float>, METRIC_COUNT> metrics;
+    std::vector<float> scores;
+    std::array<float, METRIC_COUNT> lowest{};   // range of every metric over the packed schedules
+    std::array<float, METRIC_COUNT> highest{};
+    Weights weights{};
+    bool isRanked = false;
+    size_t sorted = 0;  // order[0, sorted) is final
+
+    void score(size_t first);
+
+    // Widens the metric ranges by the schedules from position first on, true when one changed
+    bool widenRanges(size_t first);
+};
+
+#endif //SCHEDULE_RANKING_H
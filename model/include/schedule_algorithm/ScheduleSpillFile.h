@@ -0,0 +1,53 @@
+#ifndef SCHEDULE_SPILL_FILE_H
+#define SCHEDULE_SPILL_FILE_H
+
+#include "logger.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+using namespace std;
+
+// Append-only temporary file of fixed-width records, mapped into memory for reading.
+// The file is removed when the object is destroyed. Appending remaps the file, so pointers
+// returned by record() are only valid until the next append.
+class ScheduleSpillFile {
+public:
+    explicit ScheduleSpillFile(size_t recordBytes);
+    virtual ~ScheduleSpillFile();
+
+    ScheduleSpillFile(const ScheduleSpillFile&) = delete;
+    ScheduleSpillFile& operator=(const ScheduleSpillFile&) = delete;
+
+    // False when the temporary file could not be created
+    bool isOpen() const { return file != nullptr; }
+
+    size_t size() const { return recordCount; }
+    size_t recordSize() const { return recordBytes; }
+
+    // Writes count records stored back to back, returns false when the file could not take them.
+    // A failed append leaves the size unchanged and the next append writes over whatever it left.
+    bool append(const uint8_t* records, size_t count);
+
+    const uint8_t* record(size_t index) const { return mapped + index * recordBytes; }
+
+protected:
+    // Maps the first bytes of the file, the previous mapping stays when the new one fails
+    virtual bool remap(size_t bytes);
+
+private:
+    size_t recordBytes;
+    size_t recordCount = 0;
+    FILE* file = nullptr;
+    const uint8_t* mapped = nullptr;
+    size_t mappedBytes = 0;
+#ifdef _WIN32
+    void* mapping = nullptr;
+#endif
+
+    void unmap();
+};
+
+#endif //SCHEDULE_SPILL_FILE_H
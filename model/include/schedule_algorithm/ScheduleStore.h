@@ -0,0 +1,122 @@
+#ifndef SCHEDULE_STORE_H
+#define SCHEDULE_STORE_H
+
+#include "model_interfaces.h"
+#include "inner_structs.h"
+#include "ScheduleSpillFile.h"
+#include "TimeUtils.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Sort and filter keys of one schedule, same meaning as the InformativeSchedule fields
+struct ScheduleMetrics {
+    int16_t amount_days = 0;
+    int16_t amount_gaps = 0;
+    int16_t gaps_time = 0;
+    int16_t avg_start = 0;
+    int16_t avg_end = 0;
+};
+
+// Everything needed to turn option indices back into a schedule, shared by all stores of a generation
+struct ScheduleCatalog {
+    vector<Course> courses;
+    vector<vector<CourseSelection>> options;  // options[course][option], groups point into courses
+    vector<Session> blockedTimes;             // options overlapping these were left out
+    ScheduleConstraints constraints;          // every schedule meets these
+
+    // variants[course][option] holds every option with the same session times as options[course][option],
+    // that option first. Empty unless the generation collapsed same-time options.
+    vector<vector<vector<CourseSelection>>> variants;
+    unordered_map<int, CourseInfo> courseInfo;
+};
+
+// Results of a generation kept as one option index per course plus packed metrics.
+// A schedule is only expanded to an InformativeSchedule when it is shown, saved or printed.
+// Once a memory window of schedules is held they move to a memory-mapped temporary file, so very
+// large results stay readable by position without living in memory. Copies share that file.
+class ScheduleStore {
+public:
+    ScheduleStore() = default;
+    explicit ScheduleStore(shared_ptr<const ScheduleCatalog> catalog);
+
+    size_t size() const { return spilledCount + metricsList.size(); }
+    bool empty() const { return size() == 0; }
+
+    // Schedule index of the first stored schedule, the rest follow in order
+    int firstIndex() const { return baseIndex; }
+    void setFirstIndex(int index) { baseIndex = index; }
+
+    // Set when the generation stopped at a budget before finding every schedule
+    bool truncated() const { return isTruncated; }
+    void setTruncated(bool truncated) { isTruncated = truncated; }
+
+    ScheduleMetrics metrics(size_t position) const;
+    uint32_t option(size_t position, size_t course) const;
+    const shared_ptr<const ScheduleCatalog>& catalog() const { return scheduleCatalog; }
+
+    // Schedules held in memory before they move to the temporary file, 0 keeps the default
+    // of MEMORY_WINDOW_BYTES and SIZE_MAX keeps every schedule in memory
+    void setMemoryWindow(size_t schedules) { memoryWindow = schedules; }
+
+    // Schedules moved to the temporary file, the first ones of the store
+    size_t spilledSize() const { return spilledCount; }
+
+    // chosenOptions holds the option of every course, in course order
+    void add(const vector<int>& chosenOptions, const ScheduleMetrics& metrics);
+    void addFrom(const ScheduleStore& other, size_t position);
+    void append(const ScheduleStore& other);
+    void truncate(size_t count);
+    void clear();
+
+    // Memory of the schedules not moved to the temporary file
+    size_t memoryBytes() const;
+
+    // Bytes one stored schedule takes, not counting spare capacity
+    size_t bytesPerSchedule() const { return courseCount * sizeof(uint32_t) + sizeof(ScheduleMetrics); }
+
+    // Schedules with the same times as the one at position, in other groups or rooms; 1 unless options were collapsed
+    size_t variantCount(size_t position) const;
+
+    // Variant 0 is the stored schedule itself, the others are only put together here
+    InformativeSchedule materialize(size_t position, size_t variant = 0) const;
+    vector<InformativeSchedule> materializeAll() const;
+
+private:
+    static constexpr size_t MEMORY_WINDOW_BYTES = 32 * 1024 * 1024;
+
+    shared_ptr<const ScheduleCatalog> scheduleCatalog;
+    size_t courseCount = 0;
+    int baseIndex = 0;
+    bool isTruncated = false;
+
+    // Schedules [0, spilledCount) are in the file, the rest in memory
+    shared_ptr<ScheduleSpillFile> spillFile;
+    size_t spilledCount = 0;
+    size_t memoryWindow = 0;
+
+    vector<uint32_t> optionIndices;  // courseCount entries per schedule
+    vector<ScheduleMetrics> metricsList;
+
+    // A file record holds the option indices followed by the metrics, padded to keep the indices aligned
+    size_t recordBytes() const { return (bytesPerSchedule() + 3) / 4 * 4; }
+
+    void spillIfFull();
+
+    void processGroupSessions(const CourseSelection& selection,
+                              const Group* group,
+                              const string& sessionType,
+                              map<int, vector<ScheduleItem>>& daySchedules) const;
+
+    string getCourseNameById(int courseId) const;
+
+    string getCourseRawIdById(int courseId) const;
+};
+
+#endif //SCHEDULE_STORE_H
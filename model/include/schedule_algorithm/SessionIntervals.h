@@ -0,0 +1,37 @@
+#ifndef SESSION_INTERVALS_H
+#define SESSION_INTERVALS_H
+
+#include "model_interfaces.h"
+
+#include <cstdint>
+#include <vector>
+
+// Sessions packed as parallel int16 (day, start, end) arrays, so one interval is checked against
+// a whole block of them at once. Uses AVX2 when the build enables it, SSE2 on x86-64 otherwise,
+// and a scalar loop elsewhere and for the tail of every block; all give the same answers.
+class SessionIntervals {
+public:
+    // Adds a session, returns false and leaves it out when its times are missing
+    bool add(const Session& session);
+    void add(int day, int startMinutes, int endMinutes);
+
+    size_t size() const { return days.size(); }
+    bool empty() const { return days.empty(); }
+    void clear();
+
+    // True when [startMinutes, endMinutes) on the day overlaps any interval
+    bool overlaps(int day, int startMinutes, int endMinutes) const;
+
+    // True when any interval overlaps any interval of other
+    bool overlaps(const SessionIntervals& other) const;
+
+    // Same as overlaps, one interval at a time
+    bool overlapsScalar(int day, int startMinutes, int endMinutes) const;
+
+private:
+    std::vector<int16_t> days;
+    std::vector<int16_t> starts;
+    std::vector<int16_t> ends;
+};
+
+#endif //SESSION_INTERVALS_H
@@ -11,5 +11,12 @@ class TimeUtils {
 public:
     static int toMinutes(const std::string& time);
     static bool isOverlap(const Session* s1, const Session* s2);
+
+    // Parses a time the way toMinutes does, without logging or throwing. Like the stoi parse it replaced,
+    // leading whitespace, one digit minutes and anything after the minutes ("09:30:00") are accepted.
+    static bool parseMinutes(const std::string& time, int& minutes);
+
+    // Formats minutes since midnight as "HH:MM", for display and export only
+    static std::string formatMinutes(int minutes);
 };
 #endif
\ No newline at end of file
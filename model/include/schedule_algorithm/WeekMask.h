@@ -0,0 +1,84 @@
+#ifndef WEEKMASK_H
+#define WEEKMASK_H
+
+#include "model_interfaces.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+// Occupancy of the first Days days of the week as a bitmask, one bit per SlotMinutes-long slot per day.
+// The size is fixed at compile time, so a coarser grid or fewer days give a smaller mask.
+template <int SlotMinutes, int Days>
+class SlotMask {
+public:
+    static_assert(SlotMinutes > 0 && (24 * 60) % SlotMinutes == 0, "slots must divide the day");
+    static_assert(Days >= 1 && Days <= 7, "a week has at most 7 days");
+
+    static constexpr int SLOT_MINUTES = SlotMinutes;
+    static constexpr int DAYS = Days;
+    static constexpr int SLOTS_PER_DAY = 24 * 60 / SlotMinutes;
+    static constexpr int WORDS = (DAYS * SLOTS_PER_DAY + 63) / 64;
+
+    // Marks the slots covered by [startMinutes, endMinutes) on a day (1 = Sunday ... 7 = Saturday).
+    // Returns false when the interval cannot be represented exactly by whole slots.
+    bool addInterval(int day, int startMinutes, int endMinutes) {
+        if (day < 1 || day > DAYS) return false;
+        if (startMinutes < 0 || endMinutes > 24 * 60 || startMinutes >= endMinutes) return false;
+        if (startMinutes % SLOT_MINUTES != 0 || endMinutes % SLOT_MINUTES != 0) return false;
+
+        int dayOffset = (day - 1) * SLOTS_PER_DAY;
+        setRange(dayOffset + startMinutes / SLOT_MINUTES, dayOffset + endMinutes / SLOT_MINUTES);
+        return true;
+    }
+
+    // Marks the slots of a session, returns false when the session cannot be represented exactly
+    bool addSession(const Session& session) {
+        return addInterval(session.day_of_week, session.start_minutes, session.end_minutes);
+    }
+
+    bool intersects(const SlotMask& other) const {
+        for (int i = 0; i < WORDS; i++) {
+            if (words[i] & other.words[i]) return true;
+        }
+        return false;
+    }
+
+    void merge(const SlotMask& other) {
+        for (int i = 0; i < WORDS; i++) {
+            words[i] |= other.words[i];
+        }
+    }
+
+    bool empty() const {
+        for (int i = 0; i < WORDS; i++) {
+            if (words[i]) return false;
+        }
+        return true;
+    }
+
+    bool operator==(const SlotMask& other) const { return words == other.words; }
+    bool operator!=(const SlotMask& other) const { return words != other.words; }
+
+private:
+    std::array<uint64_t, WORDS> words{};
+
+    // Sets bits [firstBit, lastBit) a word at a time
+    void setRange(int firstBit, int lastBit) {
+        while (firstBit < lastBit) {
+            int word = firstBit / 64;
+            int offset = firstBit % 64;
+            int count = std::min(64 - offset, lastBit - firstBit);
+
+            uint64_t bits = count == 64 ? ~0ULL : ((1ULL << count) - 1);
+            words[word] |= bits << offset;
+
+            firstBit += count;
+        }
+    }
+};
+
+// The finest grid over the whole week, which any session on a 5-minute boundary fits
+using WeekMask = SlotMask<5, 7>;
+
+#endif //WEEKMASK_H
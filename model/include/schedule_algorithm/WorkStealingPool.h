@@ -0,0 +1,42 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include "logger.h"
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs a fixed batch of independent tasks on several threads.
+// Every worker owns a deque of task indices and takes from its back; a worker
+// that runs dry steals from the front of the other workers' deques.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threadCount);
+
+    // Runs task(i) for every i in [0, taskCount) and returns once all of them finished
+    void run(size_t taskCount, const std::function<void(size_t)>& task);
+
+    int size() const { return threadCount; }
+
+    // Number of threads worth starting on this machine
+    static int defaultThreadCount();
+
+private:
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<size_t> tasks;
+    };
+
+    int threadCount;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+    void work(int worker, const std::function<void(size_t)>& task);
+    bool popLocal(int worker, size_t& taskIndex);
+    bool steal(int thief, size_t& taskIndex);
+};
+
+#endif //WORK_STEALING_POOL_H
@@ -34,5 +34,13 @@ inline vector<const Session*> getSessions(const CourseSelection& cs) {
     return sessions;
 }
 
+// Packs the sessions of a selection for overlap checks, leaving out sessions whose times do not parse
+inline void getSessionIntervals(const CourseSelection& cs, SessionIntervals& intervals) {
+    intervals.clear();
+    for (const Session* session : getSessions(cs)) {
+        intervals.add(*session);
+    }
+}
+
 
 #endif //GET_SESSION_H
\ No newline at end of file
@@ -72,14 +72,74 @@ vector<string> Model::validateCourses(const vector<Course>& courses) {
     return allCollectedMessages;
 }
 
-vector<InformativeSchedule> Model::generateSchedules(const vector<Course>& userInput) {
-    if (userInput.empty() || userInput.size() > 8) {
+// Settings every build of a request shares; the searches add their threads and progress reports
+void Model::configureBuilder(ScheduleBuilder& builder, const ScheduleGenerationRequest& request) {
+    builder.setBudget(request.budget);
+    builder.setBlockedTimes(request.blockedTimes);
+    builder.setConstraints(request.constraints);
+    builder.setCollapseSameTimeOptions(request.collapseSameTimes);
+    builder.setCancellation(request.cancellation);
+}
+
+ScheduleStore Model::generateSchedules(const ScheduleGenerationRequest& request) {
+    const vector<Course>& userInput = request.courses;
+    if (userInput.empty()) {
+        Logger::get().logError("invalid amount of courses, aborting...");
+        return {};
+    }
+
+    ScheduleBuilder builder;
+    configureBuilder(builder, request);
+    builder.setThreadCount(WorkStealingPool::defaultThreadCount());
+    builder.setProgressCallback(request.onProgress);
+    if (request.onBatch) {
+        builder.setBatchCallback(request.onBatch, request.batchSize);
+    }
+
+    // The caller keeps the schedules of its last complete generation, the model holds no copy of them
+    BuildOutcome outcome;
+    ScheduleStore schedules = request.previous ? builder.rebuildStore(*request.previous, userInput, &outcome)
+                                               : builder.buildStore(userInput, &outcome);
+
+    if (schedules.empty() && outcome.delivered == 0) {
+        Logger::get().logError("unable to generate schedules, aborting process");
+    }
+
+    return schedules;
+}
+
+ScheduleStore Model::generateTopSchedules(const ScheduleGenerationRequest& request) {
+    const vector<Course>& userInput = request.courses;
+    if (userInput.empty()) {
+        Logger::get().logError("invalid amount of courses, aborting...");
+        return {};
+    }
+
+    ScheduleBuilder builder;
+    configureBuilder(builder, request);
+    builder.setThreadCount(WorkStealingPool::defaultThreadCount());
+    builder.setProgressCallback(request.onProgress);
+    ScheduleStore schedules = builder.buildTopK(userInput, request.objective, request.topK);
+
+    if (schedules.empty()) {
+        Logger::get().logError("unable to generate schedules, aborting process");
+    }
+
+    return schedules;
+}
+
+ScheduleStore Model::generateParetoSchedules(const ScheduleGenerationRequest& request) {
+    const vector<Course>& userInput = request.courses;
+    if (userInput.empty()) {
         Logger::get().logError("invalid amount of courses, aborting...");
         return {};
     }
 
     ScheduleBuilder builder;
-    vector<InformativeSchedule> schedules = builder.build(userInput);
+    configureBuilder(builder, request);
+    builder.setThreadCount(WorkStealingPool::defaultThreadCount());
+    builder.setProgressCallback(request.onProgress);
+    ScheduleStore schedules = builder.buildParetoFront(userInput, request.paretoObjectives);
 
     if (schedules.empty()) {
         Logger::get().logError("unable to generate schedules, aborting process");
@@ -88,6 +148,49 @@ vector<InformativeSchedule> Model::generateSchedules(const vector<Course>& userI
     return schedules;
 }
 
+bool Model::countSchedules(const ScheduleGenerationRequest& request, size_t& count) {
+    const vector<Course>& courses = request.courses;
+    if (courses.empty()) {
+        Logger::get().logError("invalid amount of courses, aborting...");
+        return false;
+    }
+
+    // A count is only a hint, it runs next to the generation and gives up after a while
+    ScheduleBuilder builder;
+    configureBuilder(builder, request);
+    builder.setBudget({0, 0, COUNT_TIME_LIMIT});
+    BuildOutcome outcome;
+    count = builder.countSchedules(courses, &outcome);
+
+    // A count cut short is only a lower bound
+    if (outcome.stopped) {
+        return false;
+    }
+    if (outcome.truncated) {
+        Logger::get().logInfo("Too many schedules to count in advance");
+        return false;
+    }
+    return true;
+}
+
+ScheduleStore Model::sampleSchedules(const ScheduleGenerationRequest& request) {
+    const vector<Course>& userInput = request.courses;
+    if (userInput.empty()) {
+        Logger::get().logError("invalid amount of courses, aborting...");
+        return {};
+    }
+
+    ScheduleBuilder builder;
+    configureBuilder(builder, request);
+    ScheduleStore schedules = builder.sampleSchedules(userInput, request.sampleSize, request.sampleSeed);
+
+    if (schedules.empty()) {
+        Logger::get().logError("unable to sample schedules, aborting process");
+    }
+
+    return schedules;
+}
+
 void Model::saveSchedule(const InformativeSchedule& infoSchedule, const string& path) {
     bool status = saveScheduleToCsv(path, infoSchedule);
     string message = status ? "Schedule saved to CSV: " + path : "An error has accrued, unable to save schedule as csv";
@@ -123,14 +226,61 @@ void* Model::executeOperation(ModelOperation operation, const void* data, const
 
         case ModelOperation::GENERATE_SCHEDULES:
             if (data) {
-                const auto* courses = static_cast<const vector<Course>*>(data);
-                lastGeneratedSchedules = generateSchedules(*courses);
-                return &lastGeneratedSchedules;
+                const auto* request = static_cast<const ScheduleGenerationRequest*>(data);
+                ScheduleStore schedules = generateSchedules(*request);
+
+                return new ScheduleStore(std::move(schedules)); // Transfer ownership to the caller
+            } else {
+                Logger::get().logError("unable to generate schedules, aborting...");
+                return nullptr;
+            }
+
+        case ModelOperation::GENERATE_TOP_K:
+            if (data) {
+                const auto* request = static_cast<const ScheduleGenerationRequest*>(data);
+                ScheduleStore schedules = generateTopSchedules(*request);
+
+                return new ScheduleStore(std::move(schedules)); // Transfer ownership to the caller
             } else {
                 Logger::get().logError("unable to generate schedules, aborting...");
                 return nullptr;
             }
 
+        case ModelOperation::GENERATE_PARETO:
+            if (data) {
+                const auto* request = static_cast<const ScheduleGenerationRequest*>(data);
+                ScheduleStore schedules = generateParetoSchedules(*request);
+
+                return new ScheduleStore(std::move(schedules)); // Transfer ownership to the caller
+            } else {
+                Logger::get().logError("unable to generate schedules, aborting...");
+                return nullptr;
+            }
+
+        case ModelOperation::COUNT_SCHEDULES:
+            if (data) {
+                const auto* request = static_cast<const ScheduleGenerationRequest*>(data);
+                size_t count = 0;
+                if (countSchedules(*request, count)) {
+                    return new size_t(count); // Transfer ownership to the caller
+                }
+                return nullptr;
+            } else {
+                Logger::get().logError("unable to count schedules, aborting...");
+                return nullptr;
+            }
+
+        case ModelOperation::SAMPLE_SCHEDULES:
+            if (data) {
+                const auto* request = static_cast<const ScheduleGenerationRequest*>(data);
+                ScheduleStore schedules = sampleSchedules(*request);
+
+                return new ScheduleStore(std::move(schedules)); // Transfer ownership to the caller
+            } else {
+                Logger::get().logError("unable to sample schedules, aborting...");
+                return nullptr;
+            }
+
         case ModelOperation::SAVE_SCHEDULE:
             if (data && !path.empty()) {
                 const auto* schedule = static_cast<const InformativeSchedule*>(data);
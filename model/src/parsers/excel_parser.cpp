@@ -148,11 +148,9 @@ vector<Session> ExcelCourseParser::parseMultipleSessions(const string& timeSlotS
     return sessions;
 }
 
-Session ExcelCourseParser::parseSingleSession(const string& timeSlotStr, const string& roomStr, const string& teacher) {
+Session ExcelCourseParser::parseSingleSession(const string& timeSlotStr, const string& roomStr, const string& /*teacher*/) {
     Session session;
     session.day_of_week = 0;
-    session.start_time = "";
-    session.end_time = "";
     session.building_number = "";
     session.room_number = "";
 
@@ -194,8 +192,14 @@ Session ExcelCourseParser::parseSingleSession(const string& timeSlotStr, const s
     smatch timeMatch;
 
     if (regex_search(timePart, timeMatch, timePattern)) {
-        session.start_time = timeMatch[1].str();
-        session.end_time = timeMatch[2].str();
+        // Times are kept as minutes only, a session whose times do not parse keeps -1 and is dropped
+        int start, end;
+        if (TimeUtils::parseMinutes(timeMatch[1].str(), start) && TimeUtils::parseMinutes(timeMatch[2].str(), end)) {
+            session.start_minutes = start;
+            session.end_minutes = end;
+        } else {
+            Logger::get().logWarning("Invalid session time ignored: " + timeMatch[0].str());
+        }
     }
 
     // Parse room format: supports both "הנדסה-1104 - 243" and "וואהל 1401 - 4"
@@ -365,6 +369,8 @@ vector<Course> ExcelCourseParser::parseExcelFile(const string& filename) {
                 case SessionType::LAB:
                     normalizedSessionTypeName = "lab";
                     break;
+                default:
+                    break;
             }
 
             // **NEW: Check if timeSlot is empty or invalid - skip this row if so**
@@ -378,7 +384,7 @@ vector<Course> ExcelCourseParser::parseExcelFile(const string& filename) {
             // **NEW: Check if any sessions were successfully parsed with valid times**
             bool hasValidSessions = false;
             for (const Session& session : sessions) {
-                if (session.day_of_week > 0 && !session.start_time.empty() && !session.end_time.empty()) {
+                if (session.day_of_week > 0 && session.start_minutes >= 0 && session.end_minutes >= 0) {
                     hasValidSessions = true;
                     break;
                 }
@@ -413,7 +419,7 @@ vector<Course> ExcelCourseParser::parseExcelFile(const string& filename) {
 
             // **MODIFIED: Only add sessions that have valid times**
             for (const Session& session : sessions) {
-                if (session.day_of_week > 0 && !session.start_time.empty() && !session.end_time.empty()) {
+                if (session.day_of_week > 0 && session.start_minutes >= 0 && session.end_minutes >= 0) {
                     courseGroupMap[courseCode][groupKey].sessions.push_back(session);
                 }
             }
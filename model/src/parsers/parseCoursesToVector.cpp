@@ -1,4 +1,5 @@
 #include "parseCoursesToVector.h"
+#include "TimeUtils.h"
 
 using namespace std;
 
@@ -224,22 +225,25 @@ Session parseSingleSession(const string& line) {
         }
 
         getline(ss, token, ',');
-        s.start_time = token;
+        string startTime = token;
 
         getline(ss, token, ',');
-        s.end_time = token;
+        string endTime = token;
 
         //  Add simple time format checks
-        if (!isValidTime(s.start_time) || !isValidTime(s.end_time)) {
+        if (!isValidTime(startTime) || !isValidTime(endTime)) {
             ostringstream message;
-            message << "Invalid time format: " + s.start_time + ", " + s.end_time;
+            message << "Invalid time format: " + startTime + ", " + endTime;
             Logger::get().logError(message.str());
             throw invalid_argument(message.str());
         }
 
-        if (s.start_time >= s.end_time) {
+        // Parsed once here, the session keeps only the minutes
+        s.start_minutes = TimeUtils::toMinutes(startTime);
+        s.end_minutes = TimeUtils::toMinutes(endTime);
+        if (s.start_minutes >= s.end_minutes) {
             ostringstream message;
-            message << "Start time must be before end time: " + s.start_time + " >= " + s.end_time;
+            message << "Start time must be before end time: " + startTime + " >= " + endTime;
             Logger::get().logError(message.str());
             throw invalid_argument(message.str());
         }
@@ -320,7 +324,7 @@ bool isInteger(const std::string& s) {
 }
 
 bool validateLocation(const string &location, int type) {
-    if (location.size()>type || location.size()<1) return false;
+    if (location.size() > static_cast<size_t>(type) || location.empty()) return false;
     if (!isInteger(location)) return false;
     return true;
 }
@@ -398,14 +402,6 @@ unordered_set<string> readSelectedCourseIDs(const string& filename) {
             }
 
             courseIDs.insert(token);
-
-            if (courseIDs.size() > 7) {
-                Logger::get().logError("More than 7 course IDs selected. Limit is 7.");
-
-                courseIDs.clear(); // discard everything
-                file.close();
-                return courseIDs;
-            }
         }
     }
 
@@ -84,15 +84,6 @@ bool scheduleContainsHebrew(const InformativeSchedule& schedule) {
     return false;
 }
 
-int getHourFromTimeString(const string& timeStr) {
-    try {
-        return stoi(timeStr.substr(0, 2));
-    } catch (const exception& e) {
-        Logger::get().logError("Error parsing time string: " + timeStr + " - " + e.what());
-        return 0;
-    }
-}
-
 bool saveScheduleToCsv(const string& filePath, const InformativeSchedule& schedule) {
     // Open file in binary mode to have full control over encoding
     ofstream csvFile(filePath, ios::binary);
@@ -131,17 +122,14 @@ bool saveScheduleToCsv(const string& filePath, const InformativeSchedule& schedu
     // Fill in the schedule data
     for (const auto& day : schedule.week) {
         for (const auto& item : day.day_items) {
-            int startHour;
-            int endHour;
-
-            try {
-                startHour = getHourFromTimeString(item.start);
-                endHour = getHourFromTimeString(item.end);
-            } catch (const exception& e) {
-                Logger::get().logError("Failed to parse time for item: " + item.courseName + " - " + e.what());
+            if (item.start_minutes < 0 || item.end_minutes < 0) {
+                Logger::get().logError("Failed to parse time for item: " + item.courseName);
                 continue;
             }
 
+            int startHour = item.start_minutes / 60;
+            int endHour = item.end_minutes / 60;
+
             for (int hour = startHour; hour < endHour; hour++) {
                 // Check if content contains Hebrew to determine language
                 bool isHebrew = containsHebrew(item.courseName) ||
@@ -1,4 +1,5 @@
 #include "printSchedule.h"
+#include "TimeUtils.h"
 
 bool printSelectedSchedule(const InformativeSchedule& schedule) {
     QPrinter printer;
@@ -47,15 +48,17 @@ bool printSelectedSchedule(const InformativeSchedule& schedule) {
 
                 if (day < static_cast<int>(schedule.week.size())) {
                     for (const auto& item : schedule.week[day].day_items) {
-                        int itemStart = std::stoi(item.start.substr(0, item.start.find(":")));
-                        int itemEnd = std::stoi(item.end.substr(0, item.end.find(":")));
+                        if (item.start_minutes < 0 || item.end_minutes < 0) continue;
+
+                        int itemStart = item.start_minutes / 60;
+                        int itemEnd = item.end_minutes / 60;
 
                         if ((itemStart <= slotStart && itemEnd > slotStart) ||
                             (itemStart >= slotStart && itemStart < slotEnd)) {
                             html += "<div style='background-color:#1f2937; color:#ffffff; padding:2px; margin-bottom:2px; border-radius:2px;'>";
                             html += "<strong style='font-size:9pt;'>" + QString::fromStdString(item.courseName) + "</strong><br/>";
                             html += "<span style='font-size:7pt;'>" + QString::fromStdString(item.raw_id) + " - " + QString::fromStdString(item.type) + "</span><br/>";
-                            html += "<span style='font-size:7pt;'><b>" + QString::fromStdString(item.start) + " - " + QString::fromStdString(item.end) + "</b></span><br/>";
+                            html += "<span style='font-size:7pt;'><b>" + QString::fromStdString(TimeUtils::formatMinutes(item.start_minutes)) + " - " + QString::fromStdString(TimeUtils::formatMinutes(item.end_minutes)) + "</b></span><br/>";
                             html += "<span style='font-size:7pt;'>Building: <b>" + QString::fromStdString(item.building) +
                                     "</b>, Room: <b>" + QString::fromStdString(item.room) + "</b></span>";
                             html += "</div>";
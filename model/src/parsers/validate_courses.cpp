@@ -1,13 +1,18 @@
 #include "validate_courses.h"
+#include "TimeUtils.h"
 #include <algorithm>
 #include <sstream>
 
 OptimizedSlot::OptimizedSlot(const string& start, const string& end, const string& id)
-        : start_time(start), end_time(end), course_id(id) {
+        : course_id(id) {
     start_minutes = toMinutes(start);
     end_minutes = toMinutes(end);
 }
 
+OptimizedSlot::OptimizedSlot(const Session& session, const string& id)
+        : course_id(id), start_minutes(session.start_minutes), end_minutes(session.end_minutes) {
+}
+
 bool OptimizedSlot::overlapsWith(const OptimizedSlot& other) const {
     return (start_minutes < other.end_minutes && other.start_minutes < end_minutes);
 }
@@ -50,7 +55,7 @@ void processSession(const Session& session, const string& courseId,
         return;
     }
 
-    if (session.start_time.empty() || session.end_time.empty()) {
+    if (session.start_minutes < 0 || session.end_minutes < 0) {
         errors.push_back("Course " + courseId + " has invalid time information");
         return;
     }
@@ -60,31 +65,32 @@ void processSession(const Session& session, const string& courseId,
     RoomSchedule& roomSchedule = schedule[roomKey];
     DaySlots& daySlots = roomSchedule[session.day_of_week];
 
-    OptimizedSlot newSlot(session.start_time, session.end_time, courseId);
-
-    if (newSlot.start_minutes == -1 || newSlot.end_minutes == -1) {
-        errors.push_back("Course " + courseId + " has invalid time format");
-        return;
-    }
+    OptimizedSlot newSlot(session, courseId);
 
     if (newSlot.start_minutes >= newSlot.end_minutes) {
         errors.push_back("Course " + courseId + " has start time after end time");
         return;
     }
 
-    for (const auto& existingSlot : daySlots) {
-        if (newSlot.overlapsWith(existingSlot)) {
-            stringstream errorMsg;
-            errorMsg << "Course " << courseId << " overlaps with " << existingSlot.course_id
-                     << " in " << session.building_number << "-" << session.room_number
-                     << " on day " << session.day_of_week
-                     << " (" << session.start_time << "-" << session.end_time
-                     << " vs " << existingSlot.start_time << "-" << existingSlot.end_time << ")";
-            errors.push_back(errorMsg.str());
+    // Most slots overlap nothing, the packed check rules that out before the slots are looked at one by one
+    if (daySlots.intervals.overlaps(0, newSlot.start_minutes, newSlot.end_minutes)) {
+        for (const auto& existingSlot : daySlots.occupied) {
+            if (newSlot.overlapsWith(existingSlot)) {
+                stringstream errorMsg;
+                errorMsg << "Course " << courseId << " overlaps with " << existingSlot.course_id
+                         << " in " << session.building_number << "-" << session.room_number
+                         << " on day " << session.day_of_week
+                         << " (" << TimeUtils::formatMinutes(newSlot.start_minutes)
+                         << "-" << TimeUtils::formatMinutes(newSlot.end_minutes)
+                         << " vs " << TimeUtils::formatMinutes(existingSlot.start_minutes)
+                         << "-" << TimeUtils::formatMinutes(existingSlot.end_minutes) << ")";
+                errors.push_back(errorMsg.str());
+            }
         }
     }
 
-    daySlots.push_back(move(newSlot));
+    daySlots.intervals.add(0, newSlot.start_minutes, newSlot.end_minutes);
+    daySlots.occupied.push_back(move(newSlot));
 }
 
 string createRoomKey(const string& building, const string& room) {
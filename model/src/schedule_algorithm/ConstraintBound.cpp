@@ -0,0 +1,98 @@
+#include "ConstraintBound.h"
+
+using namespace std;
+
+ConstraintBound::ConstraintBound(const vector<vector<CourseSelection>>& allOptions, const ScheduleConstraints& constraints)
+        : constraints(constraints),
+          latestStart(allOptions, {ScheduleMetric::AVG_START, false}),
+          earliestEnd(allOptions, {ScheduleMetric::AVG_END, true}) {
+    for (const auto& options : allOptions) {
+        WeekMask courseSlots;
+        bool coursesExact = true;
+
+        for (const auto& option : options) {
+            courseSlots.merge(option.occupancy);
+            coursesExact = coursesExact && option.occupancyExact;
+        }
+
+        reachableSlots.push_back(courseSlots);
+        exact.push_back(coursesExact ? 1 : 0);
+    }
+}
+
+bool ConstraintBound::allows(const ScheduleMetrics& metrics, const IncrementalMetrics& current) const {
+    if (constraints.maxDays >= 0 && metrics.amount_days > constraints.maxDays) return false;
+    if (constraints.maxGaps >= 0 && metrics.amount_gaps > constraints.maxGaps) return false;
+    if (constraints.maxGapMinutes >= 0 && current.longestGap() > constraints.maxGapMinutes) return false;
+
+    // Averages say nothing about a schedule without days
+    if (metrics.amount_days == 0) return true;
+    if (constraints.minAvgStart >= 0 && metrics.avg_start < constraints.minAvgStart) return false;
+    if (constraints.maxAvgEnd >= 0 && metrics.avg_end > constraints.maxAvgEnd) return false;
+    return true;
+}
+
+bool ConstraintBound::reachable(const vector<int>& chosenOptions, const IncrementalMetrics& current) const {
+    if (constraints.maxDays >= 0 && current.activeDays() > constraints.maxDays) return false;
+
+    if ((constraints.maxGaps >= 0 || constraints.maxGapMinutes >= 0) && !gapsReachable(chosenOptions, current)) {
+        return false;
+    }
+
+    // Once a day is used every completion has days, so the averages apply to all of them
+    if (current.activeDays() > 0) {
+        if (constraints.minAvgStart >= 0) {
+            int bound = latestStart.lowerBound(chosenOptions);
+            if (bound != INT_MIN && -bound < constraints.minAvgStart) return false;
+        }
+        if (constraints.maxAvgEnd >= 0) {
+            int bound = earliestEnd.lowerBound(chosenOptions);
+            if (bound != INT_MIN && bound > constraints.maxAvgEnd) return false;
+        }
+    }
+    return true;
+}
+
+// Gaps no session of an open course can fall into stay in every completion, the others may still be filled
+bool ConstraintBound::gapsReachable(const vector<int>& chosenOptions, const IncrementalMetrics& current) const {
+    WeekMask remainingSlots;
+    for (size_t course = 0; course < chosenOptions.size(); course++) {
+        if (chosenOptions[course] >= 0) continue;
+        if (!exact[course]) return true;
+        remainingSlots.merge(reachableSlots[course]);
+    }
+
+    int gaps = 0;
+    for (int day = 0; day < WeekMask::DAYS; day++) {
+        const auto& items = current.daySessions(day);
+
+        for (size_t i = 0; i + 1 < items.size(); i++) {
+            int gapDuration = items[i + 1].start - items[i].end;
+            if (gapDuration < MIN_GAP_MINUTES) continue;
+
+            WeekMask gap;
+            if (!gap.addInterval(day + 1, items[i].end, items[i + 1].start)) continue;
+            if (gap.intersects(remainingSlots)) continue;
+
+            if (constraints.maxGapMinutes >= 0 && gapDuration > constraints.maxGapMinutes) return false;
+            if (constraints.maxGaps >= 0 && ++gaps > constraints.maxGaps) return false;
+        }
+    }
+    return true;
+}
+
+vector<Session> ConstraintBound::earlyTimes(const ScheduleConstraints& constraints) {
+    vector<Session> sessions;
+    if (constraints.earliestStart <= 0) return sessions;
+
+    int minutes = min(constraints.earliestStart, 24 * 60);
+
+    for (int day = 1; day <= WeekMask::DAYS; day++) {
+        Session session;
+        session.day_of_week = day;
+        session.start_minutes = 0;
+        session.end_minutes = minutes;
+        sessions.push_back(session);
+    }
+    return sessions;
+}
@@ -1,54 +1,76 @@
 #include "CourseLegalComb.h"
 
+#include <algorithm>
+#include <map>
+#include <tuple>
+
 // Generates all valid combinations of groups (lecture, tutorial, lab) for a given course
 vector<CourseSelection> CourseLegalComb::generate(const Course& course) {
+    return combine(course,
+                   groupClasses(course.Lectures, false),
+                   groupClasses(course.Tirgulim, false),
+                   groupClasses(course.labs, false),
+                   nullptr);
+}
+
+// Generates one combination per distinct set of group times for a given course
+vector<CourseSelection> CourseLegalComb::generateDistinct(const Course& course, vector<EquivalentGroups>& equivalents) {
+    equivalents.clear();
+    return combine(course,
+                   groupClasses(course.Lectures, true),
+                   groupClasses(course.Tirgulim, true),
+                   groupClasses(course.labs, true),
+                   &equivalents);
+}
+
+vector<CourseSelection> CourseLegalComb::combine(const Course& course,
+                                                 const vector<vector<const Group*>>& lectures,
+                                                 const vector<vector<const Group*>>& tutorials,
+                                                 const vector<vector<const Group*>>& labs,
+                                                 vector<EquivalentGroups>* equivalents) {
     vector<CourseSelection> combinations;
 
     try {
         if (!course.blocks.empty()){
             const Group* blockGroupPtr = &course.blocks[0];
             combinations.push_back({course.id, nullptr, nullptr, nullptr, blockGroupPtr});
+            computeOccupancy(combinations.back());
+            if (equivalents) equivalents->push_back({{nullptr}, {nullptr}, {nullptr}});
         } else {
-            for (const auto& lectureGroup : course.Lectures) {
-                const Group* lecGroupPtr = &lectureGroup;
+            // Each group's sessions are packed once, not for every pair they are checked in
+            vector<SessionIntervals> lectureIntervals = packClasses(lectures);
+            vector<SessionIntervals> tutorialIntervals = packClasses(tutorials);
+            vector<SessionIntervals> labIntervals = packClasses(labs);
+
+            for (size_t lecture = 0; lecture < lectures.size(); lecture++) {
+                const auto& lectureClass = lectures[lecture];
+                const Group* lecGroupPtr = lectureClass.front();
 
                 if (!lecGroupPtr) {
                     Logger::get().logWarning("Null lecture group pointer encountered. Skipping.");
                     continue;
                 }
 
-                vector<const Group*> tutorials;
-                if (course.Tirgulim.empty()) {
-                    tutorials.push_back(nullptr);
-                } else {
-                    for (const auto& t : course.Tirgulim) {
-                        tutorials.push_back(&t);
-                    }
-                }
-
-                vector<const Group*> labs;
-                if (course.labs.empty()) {
-                    labs.push_back(nullptr);
-                } else {
-                    for (const auto& l : course.labs) {
-                        labs.push_back(&l);
-                    }
-                }
-
-                for (const auto* tutorialGroup : tutorials) {
-                    if (tutorialGroup && hasGroupConflict(lecGroupPtr, tutorialGroup)) {
+                for (size_t tutorial = 0; tutorial < tutorials.size(); tutorial++) {
+                    const auto& tutorialClass = tutorials[tutorial];
+                    const Group* tutorialGroup = tutorialClass.front();
+                    if (hasGroupConflict(lectureIntervals[lecture], tutorialIntervals[tutorial])) {
                         Logger::get().logInfo("Skipped due to lecture-tutorial group conflict for course ID " + to_string(course.id));
                         continue;
                     }
 
-                    for (const auto* labGroup : labs) {
-                        if ((labGroup && hasGroupConflict(lecGroupPtr, labGroup)) ||
-                            (tutorialGroup && labGroup && hasGroupConflict(tutorialGroup, labGroup))) {
+                    for (size_t lab = 0; lab < labs.size(); lab++) {
+                        const auto& labClass = labs[lab];
+                        const Group* labGroup = labClass.front();
+                        if (hasGroupConflict(lectureIntervals[lecture], labIntervals[lab]) ||
+                            hasGroupConflict(tutorialIntervals[tutorial], labIntervals[lab])) {
                             Logger::get().logInfo("Skipped due to time conflict in groups for course ID " + to_string(course.id));
                             continue;
                         }
 
                         combinations.push_back({course.id, lecGroupPtr, tutorialGroup, labGroup, nullptr});
+                        computeOccupancy(combinations.back());
+                        if (equivalents) equivalents->push_back({lectureClass, tutorialClass, labClass});
                     }
                 }
             }
@@ -60,29 +82,77 @@ vector<CourseSelection> CourseLegalComb::generate(const Course& course) {
         }
     } catch (const exception& e) {
         Logger::get().logError("Exception in CourseLegalComb::generate for course ID " + to_string(course.id) + ": " + e.what());
+        if (equivalents) equivalents->resize(combinations.size());
     }
 
     return combinations;
 }
 
-// Helper method to check if two groups have any conflicting sessions
-bool CourseLegalComb::hasGroupConflict(const Group* group1, const Group* group2) {
-    if (!group1 || !group2) {
-        return false;
+// Splits groups into classes of interchangeable groups, by identical session times when byTimes is set
+// and one group per class otherwise. No groups of a type gives a single class without a group.
+vector<vector<const Group*>> CourseLegalComb::groupClasses(const vector<Group>& groups, bool byTimes) {
+    vector<vector<const Group*>> classes;
+    if (groups.empty()) {
+        classes.push_back({nullptr});
+        return classes;
     }
 
-    try {
-        for (const auto& session1 : group1->sessions) {
-            for (const auto& session2 : group2->sessions) {
-                if (TimeUtils::isOverlap(&session1, &session2)) {
-                    return true;
-                }
-            }
+    map<vector<tuple<int, int, int>>, size_t> classOfTimes;
+    for (const auto& group : groups) {
+        if (!byTimes) {
+            classes.push_back({&group});
+            continue;
+        }
+
+        vector<tuple<int, int, int>> times;
+        for (const auto& session : group.sessions) {
+            times.emplace_back(session.day_of_week, session.start_minutes, session.end_minutes);
+        }
+        sort(times.begin(), times.end());
+
+        auto known = classOfTimes.find(times);
+        if (known != classOfTimes.end()) {
+            classes[known->second].push_back(&group);
+        } else {
+            classOfTimes.emplace(std::move(times), classes.size());
+            classes.push_back({&group});
+        }
+    }
+    return classes;
+}
+
+// Packs the sessions of the first group of every class, a class without a group gets no sessions
+vector<SessionIntervals> CourseLegalComb::packClasses(const vector<vector<const Group*>>& classes) {
+    vector<SessionIntervals> packed(classes.size());
+
+    for (size_t index = 0; index < classes.size(); index++) {
+        const Group* group = classes[index].front();
+        if (!group) continue;
+
+        for (const auto& session : group->sessions) {
+            packed[index].add(session);
+        }
+    }
+    return packed;
+}
+
+// Helper method to check if two groups have any conflicting sessions
+bool CourseLegalComb::hasGroupConflict(const SessionIntervals& group1, const SessionIntervals& group2) {
+    return group1.overlaps(group2);
+}
+
+// Precomputes the week occupancy mask of a combination, so later conflict checks are plain bit operations.
+// Combinations the mask cannot represent exactly keep their sessions packed instead.
+void CourseLegalComb::computeOccupancy(CourseSelection& selection) {
+    selection.occupancy = WeekMask();
+    selection.occupancyExact = true;
+    selection.intervals.clear();
+
+    for (const auto* session : getSessions(selection)) {
+        if (!selection.occupancy.addSession(*session)) {
+            selection.occupancyExact = false;
         }
-    } catch (const exception& e) {
-        Logger::get().logError("Exception in hasGroupConflict: " + string(e.what()));
-        return true;
     }
 
-    return false; // No conflicts found
+    if (!selection.occupancyExact) getSessionIntervals(selection, selection.intervals);
 }
\ No newline at end of file
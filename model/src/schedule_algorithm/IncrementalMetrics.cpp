@@ -0,0 +1,112 @@
+#include "IncrementalMetrics.h"
+
+#include <algorithm>
+#include <tuple>
+
+OptionMinutes::OptionMinutes(const vector<vector<CourseSelection>>& allOptions) {
+    options.resize(allOptions.size());
+    parsed.resize(allOptions.size());
+
+    for (size_t course = 0; course < allOptions.size(); course++) {
+        for (const auto& option : allOptions[course]) {
+            vector<Interval> intervals;
+            bool valid = true;
+
+            int order = 0;
+            for (const Session* session : getSessions(option)) {
+                int position = order++;
+                if (session->day_of_week < 1 || session->day_of_week > WeekMask::DAYS) continue;
+
+                if (session->start_minutes < 0 || session->end_minutes < 0) {
+                    valid = false;
+                    continue;
+                }
+                intervals.push_back({session->day_of_week - 1, session->start_minutes, session->end_minutes,
+                                     static_cast<int>(course), position});
+            }
+
+            options[course].push_back(std::move(intervals));
+            parsed[course].push_back(valid ? 1 : 0);
+        }
+    }
+}
+
+void IncrementalMetrics::add(int course, int option) {
+    if (!minutes->valid(course, option)) unparsed++;
+
+    for (const auto& interval : minutes->sessions(course, option)) {
+        Day& day = days[interval.day];
+        count(day, -1);
+
+        auto position = upper_bound(day.items.begin(), day.items.end(), interval,
+                                    [](const OptionMinutes::Interval& a, const OptionMinutes::Interval& b) {
+                                        return tie(a.start, a.course, a.order) < tie(b.start, b.course, b.order);
+                                    });
+        day.items.insert(position, interval);
+        count(day, 1);
+    }
+}
+
+void IncrementalMetrics::remove(int course, int option) {
+    if (!minutes->valid(course, option)) unparsed--;
+
+    for (const auto& interval : minutes->sessions(course, option)) {
+        Day& day = days[interval.day];
+        count(day, -1);
+
+        auto position = find_if(day.items.begin(), day.items.end(), [&](const OptionMinutes::Interval& item) {
+            return item.course == interval.course && item.order == interval.order;
+        });
+        if (position != day.items.end()) day.items.erase(position);
+        count(day, 1);
+    }
+}
+
+void IncrementalMetrics::count(Day& day, int sign) {
+    if (day.items.empty()) return;
+
+    // A day's gaps only change with its own sessions, they are worked out again as it is counted in
+    if (sign > 0) {
+        day.gaps = 0;
+        day.gapTime = 0;
+        day.longestGap = 0;
+        for (size_t i = 0; i + 1 < day.items.size(); i++) {
+            int gapDuration = day.items[i + 1].start - day.items[i].end;
+
+            if (gapDuration >= MIN_GAP_MINUTES) {
+                day.gaps++;
+                day.gapTime += gapDuration;
+                day.longestGap = max(day.longestGap, gapDuration);
+            }
+        }
+    }
+
+    totalDays += sign;
+    totalStart += sign * day.items.front().start;
+    totalEnd += sign * day.items.back().end;
+    totalGaps += sign * day.gaps;
+    totalGapTime += sign * day.gapTime;
+}
+
+int IncrementalMetrics::longestGap() const {
+    int longest = 0;
+    for (const Day& day : days) {
+        if (!day.items.empty()) longest = max(longest, day.longestGap);
+    }
+    return longest;
+}
+
+ScheduleMetrics IncrementalMetrics::metrics() const {
+    ScheduleMetrics metrics;
+    if (unparsed > 0) return metrics;
+
+    metrics.amount_days = static_cast<int16_t>(totalDays);
+    metrics.amount_gaps = static_cast<int16_t>(totalGaps);
+    metrics.gaps_time = static_cast<int16_t>(totalGapTime);
+
+    if (totalDays > 0) {
+        metrics.avg_start = static_cast<int16_t>(totalStart / totalDays);
+        metrics.avg_end = static_cast<int16_t>(totalEnd / totalDays);
+    }
+    return metrics;
+}
@@ -0,0 +1,202 @@
+#include "ObjectiveBound.h"
+
+using namespace std;
+
+void ObjectiveBound::DayReach::merge(const DayReach& other) {
+    earliestStart = min(earliestStart, other.earliestStart);
+    latestStart = max(latestStart, other.latestStart);
+    earliestEnd = min(earliestEnd, other.earliestEnd);
+    latestEnd = max(latestEnd, other.latestEnd);
+}
+
+// Summarizes where the options of every course can place sessions
+ObjectiveBound::ObjectiveBound(const vector<vector<CourseSelection>>& allOptions, const ScheduleObjective& objective)
+        : objective(objective) {
+    for (const auto& options : allOptions) {
+        CourseReach reach;
+
+        for (const auto& option : options) {
+            reach.reachableSlots.merge(option.occupancy);
+            reach.exact = reach.exact && option.occupancyExact;
+
+            reach.optionSessions.emplace_back();
+
+            for (const Session* session : getSessions(option)) {
+                if (session->day_of_week < 1 || session->day_of_week > WeekMask::DAYS) continue;
+                if (session->start_minutes < 0 || session->end_minutes < 0) {
+                    reach.valid = false;
+                    break;
+                }
+
+                SessionMinutes minutes{session->day_of_week - 1, session->start_minutes, session->end_minutes};
+                reach.optionSessions.back().push_back(minutes);
+
+                DayReach sessionReach;
+                sessionReach.earliestStart = sessionReach.latestStart = minutes.start;
+                sessionReach.earliestEnd = sessionReach.latestEnd = minutes.end;
+                reach.days[minutes.day].merge(sessionReach);
+            }
+        }
+
+        courses.push_back(reach);
+    }
+}
+
+int ObjectiveBound::score(const ScheduleMetrics& metrics) const {
+    int value = 0;
+    switch (objective.metric) {
+        case ScheduleMetric::AMOUNT_DAYS: value = metrics.amount_days; break;
+        case ScheduleMetric::AMOUNT_GAPS: value = metrics.amount_gaps; break;
+        case ScheduleMetric::GAPS_TIME:   value = metrics.gaps_time; break;
+        case ScheduleMetric::AVG_START:   value = metrics.avg_start; break;
+        case ScheduleMetric::AVG_END:     value = metrics.avg_end; break;
+    }
+    return objective.ascending ? value : -value;
+}
+
+bool ObjectiveBound::canPrune() const {
+    bool gaps = objective.metric == ScheduleMetric::AMOUNT_GAPS || objective.metric == ScheduleMetric::GAPS_TIME;
+    return !(gaps && !objective.ascending);
+}
+
+int ObjectiveBound::lowerBound(const vector<int>& chosenOptions) const {
+    if (!canPrune()) return INT_MIN;
+
+    array<DayReach, WeekMask::DAYS> remaining;
+    WeekMask remainingSlots;
+    bool remainingExact = true;
+
+    for (size_t course = 0; course < courses.size(); course++) {
+        if (!courses[course].valid) return INT_MIN;
+        if (chosenOptions[course] >= 0) continue;
+
+        for (int day = 0; day < WeekMask::DAYS; day++) {
+            remaining[day].merge(courses[course].days[day]);
+        }
+        remainingSlots.merge(courses[course].reachableSlots);
+        remainingExact = remainingExact && courses[course].exact;
+    }
+
+    // start and end minutes of the sessions chosen so far, per day, in the order the metrics use.
+    // Called for every search node, so the buffers are kept per thread
+    thread_local array<vector<pair<int, int>>, WeekMask::DAYS> days;
+    for (auto& items : days) {
+        items.clear();
+    }
+
+    for (size_t course = 0; course < courses.size(); course++) {
+        if (chosenOptions[course] < 0) continue;
+
+        for (const SessionMinutes& session : courses[course].optionSessions[chosenOptions[course]]) {
+            days[session.day].emplace_back(session.start, session.end);
+        }
+    }
+
+    for (auto& items : days) {
+        stable_sort(items.begin(), items.end(), [](const pair<int, int>& a, const pair<int, int>& b) {
+            return a.first < b.first;
+        });
+    }
+
+    switch (objective.metric) {
+        case ScheduleMetric::AMOUNT_DAYS: {
+            int used = 0;
+            int reachable = 0;
+            for (int day = 0; day < WeekMask::DAYS; day++) {
+                if (!days[day].empty()) used++;
+                else if (remaining[day].reachable()) reachable++;
+            }
+            return objective.ascending ? used : -(used + reachable);
+        }
+
+        case ScheduleMetric::AMOUNT_GAPS:
+        case ScheduleMetric::GAPS_TIME:
+            // Later courses may fill a gap, so only the fewest gaps can be bounded (see canPrune)
+            if (!remainingExact) return 0;
+            return gapsBound(days, remainingSlots);
+
+        case ScheduleMetric::AVG_START:
+        case ScheduleMetric::AVG_END:
+            return averageBound(days, remaining);
+    }
+    return INT_MIN;
+}
+
+// Gaps no session of a remaining course can fall into stay gaps in every completion
+int ObjectiveBound::gapsBound(const array<vector<pair<int, int>>, WeekMask::DAYS>& days,
+                              const WeekMask& remainingSlots) const {
+    int total = 0;
+
+    for (int day = 0; day < WeekMask::DAYS; day++) {
+        const auto& items = days[day];
+
+        for (size_t i = 0; i + 1 < items.size(); i++) {
+            int gapDuration = items[i + 1].first - items[i].second;
+            if (gapDuration < MIN_GAP_MINUTES) continue;
+
+            WeekMask gap;
+            if (!gap.addInterval(day + 1, items[i].second, items[i + 1].first)) continue;
+            if (gap.intersects(remainingSlots)) continue;
+
+            total += objective.metric == ScheduleMetric::AMOUNT_GAPS ? 1 : gapDuration;
+        }
+    }
+    return total;
+}
+
+// Every used day keeps a value within reach of the remaining courses, every unused day may join
+// with any value the remaining courses reach on it; the best mean over those choices bounds the metric
+int ObjectiveBound::averageBound(const array<vector<pair<int, int>>, WeekMask::DAYS>& days,
+                                 const array<DayReach, WeekMask::DAYS>& remaining) const {
+    bool byStart = objective.metric == ScheduleMetric::AVG_START;
+    bool lowest = objective.ascending;
+
+    int sum = 0;
+    int count = 0;
+    thread_local vector<int> optional;
+    optional.clear();
+
+    for (int day = 0; day < WeekMask::DAYS; day++) {
+        const DayReach& reach = remaining[day];
+
+        if (!days[day].empty()) {
+            // A day can only start earlier and end later than it does now
+            int value = byStart ? days[day].front().first : days[day].back().second;
+            if (reach.reachable()) {
+                if (byStart && lowest) value = min(value, reach.earliestStart);
+                if (!byStart && !lowest) value = max(value, reach.latestEnd);
+            }
+            sum += value;
+            count++;
+        } else if (reach.reachable()) {
+            if (byStart) optional.push_back(lowest ? reach.earliestStart : reach.latestStart);
+            else optional.push_back(lowest ? reach.earliestEnd : reach.latestEnd);
+        }
+    }
+
+    int mean = boundedMean(sum, count, optional, lowest);
+    return lowest ? mean : -mean;
+}
+
+// Lowest or highest mean of count values summing to sum plus any subset of optional, rounded down like the metrics
+int ObjectiveBound::boundedMean(int sum, int count, vector<int>& optional, bool lowest) {
+    if (lowest) sort(optional.begin(), optional.end());
+    else sort(optional.begin(), optional.end(), greater<int>());
+
+    size_t next = 0;
+    if (count == 0) {
+        // A schedule without any day averages 0, below every real time
+        if (lowest || optional.empty()) return 0;
+        sum = optional[next++];
+        count = 1;
+    }
+
+    for (; next < optional.size(); next++) {
+        int value = optional[next];
+        bool improves = lowest ? value * count < sum : value * count > sum;
+        if (!improves) break;
+        sum += value;
+        count++;
+    }
+    return sum / count;
+}
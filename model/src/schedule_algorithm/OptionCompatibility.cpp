@@ -0,0 +1,77 @@
+#include "OptionCompatibility.h"
+
+using namespace std;
+
+// Builds the compatibility table by checking every pair of options from different courses once
+OptionCompatibility::OptionCompatibility(const vector<vector<CourseSelection>>& allOptions, ConflictCheck hasConflict)
+        : OptionCompatibility(countOptions(allOptions), [&](int course, int option, int otherCourse, int otherOption) {
+              return hasConflict(allOptions[course][option], allOptions[otherCourse][otherOption]);
+          }) {
+}
+
+void OptionCompatibility::layout(const vector<int>& counts) {
+    size_t totalOptions = 0;
+
+    for (int count : counts) {
+        optionCounts.push_back(count);
+        wordCounts.push_back((count + 63) / 64);
+        optionOffsets.push_back(totalOptions);
+        courseOffsets.push_back(rowWords);
+
+        totalOptions += count;
+        rowWords += wordCounts.back();
+    }
+
+    bits.assign(totalOptions * rowWords, 0);
+}
+
+vector<int> OptionCompatibility::countOptions(const vector<vector<CourseSelection>>& allOptions) {
+    vector<int> counts;
+    for (const auto& options : allOptions) {
+        counts.push_back(static_cast<int>(options.size()));
+    }
+    return counts;
+}
+
+void OptionCompatibility::fillAll(int course, vector<uint64_t>& target) const {
+    int count = optionCounts[course];
+    target.assign(wordCounts[course], ~0ULL);
+
+    if (count % 64 != 0) {
+        target.back() = (1ULL << (count % 64)) - 1;
+    }
+}
+
+void OptionCompatibility::fillDomains(vector<uint64_t>& domains) const {
+    domains.assign(rowWords, 0);
+
+    vector<uint64_t> all;
+    for (int course = 0; course < courseCount(); course++) {
+        fillAll(course, all);
+        copy(all.begin(), all.end(), domains.begin() + courseOffsets[course]);
+    }
+}
+
+bool OptionCompatibility::narrowDomains(int course, int option, const vector<int>& courses,
+                                        const uint64_t* domains, uint64_t* target) const {
+    const uint64_t* compatible = &bits[(optionOffsets[course] + option) * rowWords];
+
+    for (int other : courses) {
+        uint64_t remaining = 0;
+        for (size_t word = courseOffsets[other]; word < courseOffsets[other] + wordCounts[other]; word++) {
+            target[word] = domains[word] & compatible[word];
+            remaining |= target[word];
+        }
+
+        if (remaining == 0) return false;
+    }
+    return true;
+}
+
+int OptionCompatibility::remainingOptions(int course, const uint64_t* domains) const {
+    int count = 0;
+    for (size_t word = courseOffsets[course]; word < courseOffsets[course] + wordCounts[course]; word++) {
+        count += bitCount(domains[word]);
+    }
+    return count;
+}
@@ -2,257 +2,618 @@
 
 using namespace std;
 
-unordered_map<int, CourseInfo> ScheduleBuilder::courseInfoMap;
+// Recursive backtracking function to build all valid schedules.
+// Courses are taken fewest remaining options first; each schedule keeps its options in course order.
+void ScheduleBuilder::backtrack(BuildRun& run,
+                                int depth,
+                                const vector<vector<CourseSelection>>& allOptions,
+                                const OptionCompatibility& compatibility,
+                                SearchState& state) const {
+    try {
+        if (run.stopRequested.load(memory_order_relaxed) || run.budgetExhausted.load(memory_order_relaxed)) return;
+        if (state.full || checkpoint(run, state)) return;
 
-// Checks if there is a time conflict between two CourseSelections
-bool ScheduleBuilder::hasConflict(const CourseSelection& a, const CourseSelection& b) {
-    vector<const Session*> aSessions = getSessions(a);
-    vector<const Session*> bSessions = getSessions(b);
+        if (static_cast<size_t>(depth) == allOptions.size()) {
+            completeSchedule(run, state);
+            return;
+        }
 
-    // Compare each session in a with each session in b
-    for (const auto* s1 : aSessions) {
-        for (const auto* s2 : bSessions) {
-            if (TimeUtils::isOverlap(s1, s2)) return true;
+        // Nothing below can beat the k-th best schedule found so far
+        if (run.topK && depth > 0 && run.topK->bound.canPrune()) {
+            int worstScore = run.topK->worstScore.load(memory_order_relaxed);
+            if (worstScore != INT_MAX && run.topK->bound.lowerBound(state.chosenOptions) > worstScore) {
+                return;
+            }
         }
-    }
-    return false;
-}
 
-// Recursive backtracking function to build all valid schedules
-void ScheduleBuilder::backtrack(int currentCourse,
-                                const vector<vector<CourseSelection>>& allOptions,
-                                vector<CourseSelection>& currentCombination,
-                                vector<InformativeSchedule>& results) {
-    try {
-        if (currentCourse == allOptions.size()) {
-            results.push_back(convertToInformativeSchedule(currentCombination, results.size()));
+        // A schedule found already is at least as good on every objective as anything below
+        if (run.pareto && depth > 0 && run.pareto->canPrune && paretoCovered(run, state)) {
             return;
         }
 
-        for (const auto& option : allOptions[currentCourse]) {
-            bool conflict = false;
+        // No completion can meet the constraints
+        if (run.constraintBound && depth > 0 && !run.constraintBound->reachable(state.chosenOptions, state.metrics)) {
+            return;
+        }
+
+        // Every option left in the domain fits the options chosen so far
+        const vector<uint64_t>& domains = state.domainsByLevel[depth];
+        vector<uint64_t>& nextDomains = state.domainsByLevel[depth + 1];
+
+        size_t position = selectCourse(compatibility, state.openCourses, domains);
+        int course = state.openCourses[position];
+        state.openCourses.erase(state.openCourses.begin() + position);
+
+        // The top levels split the tree into equal shares per option, finished branches count as explored
+        bool tracked = state.tracksProgress && depth < PROGRESS_DEPTH;
+        double exploredBefore = state.explored;
+        double parentShare = state.branchShare;
+        int branch = 0;
+        if (tracked) {
+            state.branchShare /= max(1, compatibility.remainingOptions(course, domains.data()));
+        }
 
-            for (const auto& selected : currentCombination) {
-                if (hasConflict(option, selected)) {
-                    conflict = true;
-                    break;
+        size_t offset = compatibility.domainOffset(course);
+        for (int word = 0; word < compatibility.wordCount(course); word++) {
+            uint64_t remaining = domains[offset + word];
+
+            while (remaining) {
+                int option = word * 64 + OptionCompatibility::lowestSetBit(remaining);
+                remaining &= remaining - 1;
+
+                // Forward checking: skip the option when it leaves an open course without options
+                if (compatibility.narrowDomains(course, option, state.openCourses,
+                                                domains.data(), nextDomains.data())) {
+                    state.chosenOptions[course] = option;
+                    state.metrics.add(course, option);
+                    backtrack(run, depth + 1, allOptions, compatibility, state);
+                    state.metrics.remove(course, option);
                 }
-            }
 
-            if (!conflict) {
-                currentCombination.push_back(option);
-                backtrack(currentCourse + 1, allOptions, currentCombination, results);
-                currentCombination.pop_back();
+                if (tracked) {
+                    state.explored = exploredBefore + ++branch * state.branchShare;
+                }
             }
         }
+
+        state.branchShare = parentShare;
+        state.chosenOptions[course] = -1;
+        state.openCourses.insert(state.openCourses.begin() + position, course);
     } catch (const exception& e) {
         Logger::get().logError("Exception in ScheduleBuilder::backtrack: " + string(e.what()));
     }
 }
 
-// Public method to build all possible valid schedules from a list of courses
-vector<InformativeSchedule> ScheduleBuilder::build(const vector<Course>& courses) {
-    Logger::get().logInfo("Starting schedule generation for " + to_string(courses.size()) + " courses.");
-
-    vector<InformativeSchedule> results;
-    try {
-        buildCourseInfoMap(courses);
+// Keeps the schedule every course of state has an option for
+void ScheduleBuilder::completeSchedule(BuildRun& run, SearchState& state) const {
+    ScheduleMetrics metrics = state.metrics.metrics();
+    if (run.constraintBound && !run.constraintBound->allows(metrics, state.metrics)) return;
 
-        CourseLegalComb generator;
-        vector<vector<CourseSelection>> allOptions;
+    if (run.countOnly) {
+        state.found++;
+        return;
+    }
 
-        // Generate combinations for each course
-        for (const auto& course : courses) {
-            auto combinations = generator.generate(course);
-            Logger::get().logInfo("Generated " + to_string(combinations.size()) + " combinations for course ID " + to_string(course.id));
-            allOptions.push_back(std::move(combinations)); // Store the combinations
-        }
+    if (run.topK) {
+        offerTopK(run, state, metrics);
+        state.sequence++;
+        return;
+    }
 
-        vector<CourseSelection> current;
-        backtrack(0, allOptions, current, results);
+    if (run.pareto) {
+        offerPareto(run, state, metrics);
+        state.sequence++;
+        return;
+    }
 
-        Logger::get().logInfo("Finished schedule generation. Total valid schedules: " + to_string(results.size()));
-    } catch (const exception& e) {
-        // Log any exceptions that occur during schedule generation
-        Logger::get().logError("Exception in ScheduleBuilder::build: " + string(e.what()));
+    // One more schedule than the limit allows, the result is cut here
+    if (state.found >= state.resultCap) {
+        state.full = true;
+        if (state.limitEndsSearch) exhaustBudget(run, "result");
+        return;
     }
 
-    return results;
+    state.found++;
+    state.results.add(state.chosenOptions, metrics);
+    if (run.tasks) run.tasks->found[state.task].store(state.found, memory_order_relaxed);
+    if (state.results.size() >= state.flushAt) {
+        deliverBatch(run, state.results);
+    }
 }
 
-// Helper method to build course info map
-void ScheduleBuilder::buildCourseInfoMap(const vector<Course>& courses) {
-    courseInfoMap.clear();
-    for (const auto& course : courses) {
-        courseInfoMap[course.id] = {course.raw_id, course.name};
+// Position in openCourses of the course with the fewest options left, the first one on ties
+size_t ScheduleBuilder::selectCourse(const OptionCompatibility& compatibility,
+                                     const vector<int>& openCourses,
+                                     const vector<uint64_t>& domains) {
+    size_t best = 0;
+    int fewest = INT_MAX;
+
+    for (size_t position = 0; position < openCourses.size(); position++) {
+        int count = compatibility.remainingOptions(openCourses[position], domains.data());
+        if (count < fewest) {
+            fewest = count;
+            best = position;
+        }
     }
+    return best;
 }
 
-// Converts a vector of CourseSelections to an InformativeSchedule
-InformativeSchedule ScheduleBuilder::convertToInformativeSchedule(const vector<CourseSelection>& selections, int index) const {
-    InformativeSchedule schedule;
-    schedule.index = index;
+// Starts every course open with all of its options, one domain set per search level
+void ScheduleBuilder::prepareSearchState(const OptionCompatibility& compatibility, SearchState& state) {
+    int courseCount = compatibility.courseCount();
 
-    try {
-        map<int, vector<ScheduleItem>> daySchedules;
+    state.domainsByLevel.assign(courseCount + 1, vector<uint64_t>(compatibility.domainWords(), 0));
+    compatibility.fillDomains(state.domainsByLevel[0]);
 
-        const vector<string> dayNames = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
+    state.chosenOptions.assign(courseCount, -1);
+    state.openCourses.resize(courseCount);
+    iota(state.openCourses.begin(), state.openCourses.end(), 0);
+}
 
-        for (const auto& selection : selections) {
-            if (selection.lectureGroup) {
-                processGroupSessions(selection, selection.lectureGroup, "Lecture", daySchedules);
-            }
+// Enumerates the valid partial assignments of the first splitDepth search levels, in search order.
+// A prefix holds the option of every course it assigns and -1 for the rest; its share is the
+// fraction of the search tree below it, as backtrack counts progress.
+void ScheduleBuilder::collectPrefixes(int depth,
+                                      int splitDepth,
+                                      const OptionCompatibility& compatibility,
+                                      SearchState& state,
+                                      vector<vector<int>>& prefixes,
+                                      vector<double>& shares) {
+    if (depth == splitDepth) {
+        prefixes.push_back(state.chosenOptions);
+        shares.push_back(state.branchShare);
+        return;
+    }
 
-            if (selection.tutorialGroup) {
-                processGroupSessions(selection, selection.tutorialGroup, "Tutorial", daySchedules);
-            }
+    const vector<uint64_t>& domains = state.domainsByLevel[depth];
+    vector<uint64_t>& nextDomains = state.domainsByLevel[depth + 1];
 
-            if (selection.labGroup) {
-                processGroupSessions(selection, selection.labGroup, "Lab", daySchedules);
-            }
+    size_t position = selectCourse(compatibility, state.openCourses, domains);
+    int course = state.openCourses[position];
+    state.openCourses.erase(state.openCourses.begin() + position);
+
+    double parentShare = state.branchShare;
+    state.branchShare /= max(1, compatibility.remainingOptions(course, domains.data()));
+
+    size_t offset = compatibility.domainOffset(course);
+    for (int word = 0; word < compatibility.wordCount(course); word++) {
+        uint64_t remaining = domains[offset + word];
+
+        while (remaining) {
+            int option = word * 64 + OptionCompatibility::lowestSetBit(remaining);
+            remaining &= remaining - 1;
 
-            if (selection.blockGroup) {
-                processGroupSessions(selection, selection.blockGroup, "Block", daySchedules);
+            if (!compatibility.narrowDomains(course, option, state.openCourses, domains.data(), nextDomains.data())) {
+                continue;
             }
+
+            state.chosenOptions[course] = option;
+            collectPrefixes(depth + 1, splitDepth, compatibility, state, prefixes, shares);
         }
+    }
 
-        for (int day = 0; day < 7; day++) {
-            ScheduleDay scheduleDay;
-            scheduleDay.day = dayNames[day];
+    state.branchShare = parentShare;
+    state.chosenOptions[course] = -1;
+    state.openCourses.insert(state.openCourses.begin() + position, course);
+}
 
-            int algorithmDay = day + 1;
+// Splits the first levels of the search tree into tasks and runs them on a work-stealing pool.
+// Every task fills its own buffer; buffers are merged in task order, which is the sequential
+// search order, so schedule indices do not depend on the thread count.
+// Each finished buffer is merged, or queued for the batch callback when streaming, as soon as every earlier task has finished;
+// the callback itself runs outside the lock.
+// Under a result limit a task only keeps what the earlier tasks leave of it, and finished buffers are trimmed
+// as the earlier tasks find more, so unmerged buffers never hold much more than the limit between them.
+// Progress is counted per finished task.
+void ScheduleBuilder::searchInParallel(BuildRun& run,
+                                       const vector<vector<CourseSelection>>& allOptions,
+                                       const OptionCompatibility& compatibility,
+                                       const OptionMinutes& minutes,
+                                       ScheduleStore& results) const {
+    WorkStealingPool pool(threadCount);
+
+    SearchState prefixState;
+    prepareSearchState(compatibility, prefixState);
+
+    int splitDepth = 1;
+    vector<vector<int>> prefixes;
+    vector<double> shares;
+    collectPrefixes(0, splitDepth, compatibility, prefixState, prefixes, shares);
+
+    if (allOptions.size() > 2 && prefixes.size() < static_cast<size_t>(pool.size() * TASKS_PER_THREAD)) {
+        splitDepth = 2;
+        prefixes.clear();
+        shares.clear();
+        collectPrefixes(0, splitDepth, compatibility, prefixState, prefixes, shares);
+    }
 
-            if (daySchedules.find(algorithmDay) != daySchedules.end()) {
-                auto& dayItems = daySchedules[algorithmDay];
-                sort(dayItems.begin(), dayItems.end(), [](const ScheduleItem& a, const ScheduleItem& b) {
-                    return TimeUtils::toMinutes(a.start) < TimeUtils::toMinutes(b.start);
-                });
-                scheduleDay.day_items = dayItems;
-            }
+    Logger::get().logInfo("Searching " + to_string(prefixes.size()) + " subtrees on " + to_string(pool.size()) + " threads");
+
+    // Taken once, results is swapped out by deliveries while tasks still start
+    shared_ptr<const ScheduleCatalog> catalog = results.catalog();
+
+    run.tasks = make_unique<TaskBuffers>(prefixes.size(), catalog);
+    TaskBuffers& tasks = *run.tasks;
+    bool limited = run.resultLimit != SIZE_MAX;
+    run.exploredTasks = 0;
+
+    pool.run(prefixes.size(), [&](size_t task) {
+        SearchState state;
+        state.results = ScheduleStore(catalog);
+        state.task = task;
+        state.limitEndsSearch = false;  // earlier tasks may still fill the result limit
+        state.metrics = IncrementalMetrics(&minutes);
+        prepareSearchState(compatibility, state);
+
+        // Earlier tasks already found more than the limit holds, none of this task's schedules would be kept.
+        // With exactly the limit the task still runs, its first schedule tells the result is truncated.
+        size_t before = limited ? schedulesBefore(run, task) : 0;
+        bool skipped = before > run.resultLimit;
+        if (limited) state.resultCap = run.resultLimit - min(before, run.resultLimit);
+
+        const vector<int>& prefix = prefixes[task];
+        state.openCourses.clear();
+        for (int course = 0; course < static_cast<int>(prefix.size()); course++) {
+            if (prefix[course] < 0) state.openCourses.push_back(course);
+        }
 
-            schedule.week.push_back(scheduleDay);
+        // Narrow the open courses by the prefix; the prefix search already checked none empties
+        int depth = 0;
+        for (int course = 0; course < static_cast<int>(prefix.size()); course++) {
+            if (prefix[course] < 0) continue;
+
+            compatibility.narrowDomains(course, prefix[course], state.openCourses,
+                                        state.domainsByLevel[depth].data(),
+                                        state.domainsByLevel[depth + 1].data());
+            state.chosenOptions[course] = prefix[course];
+            state.metrics.add(course, prefix[course]);
+            depth++;
         }
 
-        calculateScheduleMetrics(schedule);
+        if (!skipped) {
+            backtrack(run, splitDepth, allOptions, compatibility, state);
+        }
 
-    } catch (const exception& e) {
-        Logger::get().logError("Exception in convertToInformativeSchedule: " + string(e.what()));
-        schedule.week.clear();
-        const vector<string> dayNames = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
-        for (int day = 0; day < 7; day++) {
-            ScheduleDay scheduleDay;
-            scheduleDay.day = dayNames[day];
-            schedule.week.push_back(scheduleDay);
+        // Merged as soon as every earlier task finished, so the result limit can stop the other tasks
+        {
+            lock_guard<mutex> guard(run.deliveryLock);
+            tasks.buffers[task] = std::move(state.results);
+            tasks.buffers[task].setTruncated(state.full);
+            tasks.finished[task] = 1;
+            run.exploredTasks += shares[task];
+            reportProgress(run, run.exploredTasks);
+            if (limited) trimFinishedTasks(run);
+            while (tasks.nextToMerge < tasks.buffers.size() && tasks.finished[tasks.nextToMerge]) {
+                appendInOrder(run, tasks.buffers[tasks.nextToMerge], results);
+                tasks.buffers[tasks.nextToMerge++] = ScheduleStore();
+            }
+        }
+        if (batchCallback) sendBatches(run);
+    });
+
+    {
+        lock_guard<mutex> guard(run.deliveryLock);
+        for (; tasks.nextToMerge < tasks.buffers.size(); tasks.nextToMerge++) {
+            appendInOrder(run, tasks.buffers[tasks.nextToMerge], results);
+            tasks.buffers[tasks.nextToMerge] = ScheduleStore();
         }
     }
+    if (batchCallback) sendBatches(run);
+    run.tasks.reset();
+}
 
-    return schedule;
+size_t ScheduleBuilder::schedulesBefore(const BuildRun& run, size_t task) {
+    size_t before = 0;
+    for (size_t earlier = 0; earlier < task; earlier++) {
+        before += run.tasks->found[earlier].load(memory_order_relaxed);
+    }
+    return before;
 }
 
-// Helper method to process all sessions in a group and add them to the day schedules
-void ScheduleBuilder::processGroupSessions(const CourseSelection& selection,
-                                           const Group* group,
-                                           const string& sessionType,
-                                           map<int, vector<ScheduleItem>>& daySchedules) {
-    if (!group) return;
+// Schedules past the task's part are dropped, they fall behind the limit whatever the earlier tasks still find
+bool ScheduleBuilder::limitTask(BuildRun& run, SearchState& state) {
+    size_t before = schedulesBefore(run, state.task);
+    state.resultCap = run.resultLimit - min(before, run.resultLimit);
+
+    if (state.found > state.resultCap) {
+        state.results.truncate(state.resultCap);
+        state.found = state.resultCap;
+        run.tasks->found[state.task].store(state.found, memory_order_relaxed);
+        state.full = true;
+        return false;
+    }
 
-    try {
-        string courseName = getCourseNameById(selection.courseId);
-        string courseRawId = getCourseRawIdById(selection.courseId);
+    // Later tasks that finished meanwhile may now hold schedules past the limit
+    if (state.found != state.foundAtTrim) {
+        state.foundAtTrim = state.found;
+        lock_guard<mutex> guard(run.deliveryLock);
+        trimFinishedTasks(run);
+    }
+    return true;
+}
 
-        for (const auto& session : group->sessions) {
+void ScheduleBuilder::trimFinishedTasks(BuildRun& run) {
+    TaskBuffers& tasks = *run.tasks;
+    size_t before = 0;
+
+    for (size_t task = 0; task < tasks.buffers.size(); task++) {
+        if (task >= tasks.nextToMerge && tasks.finished[task]) {
+            size_t allowance = run.resultLimit - min(before, run.resultLimit);
+            if (tasks.buffers[task].size() > allowance) {
+                tasks.buffers[task].truncate(allowance);
+                tasks.buffers[task].setTruncated(true);
+                tasks.found[task].store(allowance, memory_order_relaxed);
+            }
+        }
+        before += tasks.found[task].load(memory_order_relaxed);
+    }
+}
 
-            ScheduleItem item;
-            item.courseName = courseName;
-            item.raw_id = courseRawId;
-            item.type = sessionType;
-            item.start = session.start_time;
-            item.end = session.end_time;
-            item.building = session.building_number;
-            item.room = session.room_number;
+// Adds a task's schedules behind the ones already merged, up to the result limit,
+// queueing full batches when streaming. Called under deliveryLock.
+void ScheduleBuilder::appendInOrder(BuildRun& run, const ScheduleStore& buffer, ScheduleStore& results) const {
+    size_t merged = run.deliveredCount + results.size();
+
+    if (!batchCallback && merged + buffer.size() <= run.resultLimit) {
+        results.append(buffer);
+    } else {
+        for (size_t position = 0; position < buffer.size(); position++) {
+            if (run.deliveredCount + results.size() == run.resultLimit) {
+                exhaustBudget(run, "result");
+                return;
+            }
 
-            daySchedules[session.day_of_week].push_back(item);
+            results.addFrom(buffer, position);
+            if (batchCallback && results.size() >= batchSize) {
+                queueBatch(run, results);
+            }
         }
+    }
 
-    } catch (const exception& e) {
-        Logger::get().logError("Exception in processGroupSessions: " + string(e.what()));
+    // The task itself stopped at the limit, it had more schedules than fit
+    if (buffer.truncated()) {
+        exhaustBudget(run, "result");
     }
 }
 
-string ScheduleBuilder::getCourseNameById(int courseId) {
-    auto it = courseInfoMap.find(courseId);
-    if (it != courseInfoMap.end()) {
-        return it->second.name;
+// Derives the result limit from the budget and starts the clock
+void ScheduleBuilder::startBudget(BuildRun& run, size_t bytesPerSchedule) const {
+    run.budgetExhausted = false;
+
+    run.resultLimit = budget.maxResults == 0 ? SIZE_MAX : budget.maxResults;
+    if (budget.maxMemoryBytes != 0 && bytesPerSchedule != 0) {
+        run.resultLimit = min(run.resultLimit, budget.maxMemoryBytes / bytesPerSchedule);
     }
-    Logger::get().logWarning("Course ID " + to_string(courseId) + " not found in course info map");
-    return "Unknown Course";
+
+    run.deadline = chrono::steady_clock::now() + budget.maxTime;
+    run.lastProgressReport = 0;
+
+    // A generation cancelled before it started does not search at all
+    checkCancellation(run);
 }
 
-string ScheduleBuilder::getCourseRawIdById(int courseId) {
-    auto it = courseInfoMap.find(courseId);
-    if (it != courseInfoMap.end()) {
-        return it->second.raw_id;
+// Called at every search node, returns true when the search has to stop.
+// Only every CHECKPOINT_INTERVAL nodes looks at the cancellation token, the clock and the progress.
+bool ScheduleBuilder::checkpoint(BuildRun& run, SearchState& state) const {
+    if (++state.visited % CHECKPOINT_INTERVAL != 0) return false;
+
+    if (checkCancellation(run)) return true;
+
+    if (budget.maxTime.count() != 0 && chrono::steady_clock::now() >= run.deadline) {
+        exhaustBudget(run, "time");
+        return true;
     }
-    Logger::get().logWarning("Course ID " + to_string(courseId) + " not found in course info map");
-    return "UNKNOWN";
+
+    if (state.tracksProgress) {
+        reportProgress(run, state.explored);
+    }
+
+    if (run.tasks && run.resultLimit != SIZE_MAX && !limitTask(run, state)) return true;
+    return false;
 }
 
-void ScheduleBuilder::calculateScheduleMetrics(InformativeSchedule& schedule) {
-    int totalDaysWithItems = 0;
-    int totalGaps = 0;
-    int totalGapTime = 0;
-    int totalStartTime = 0;
-    int totalEndTime = 0;
+// Stops every search once the token is cancelled, the schedules found so far are kept
+bool ScheduleBuilder::checkCancellation(BuildRun& run) const {
+    if (!cancellation || !cancellation->isCancelled()) return false;
 
-    try {
-        for (const auto& scheduleDay : schedule.week) {
-            if (scheduleDay.day_items.empty()) {
-                continue;
-            }
+    if (!run.stopRequested.exchange(true)) {
+        Logger::get().logInfo("Schedule generation cancelled");
+    }
+    return true;
+}
 
-            // calculate amount of none empty days
-            totalDaysWithItems++;
+// Passes the progress on unless the last report is less than PROGRESS_INTERVAL old
+void ScheduleBuilder::reportProgress(BuildRun& run, double explored) const {
+    if (!progressCallback) return;
 
-            // start and end times for day
-            int dayStartMinutes = TimeUtils::toMinutes(scheduleDay.day_items.front().start);
-            int dayEndMinutes = TimeUtils::toMinutes(scheduleDay.day_items.back().end);
+    chrono::steady_clock::rep now = chrono::steady_clock::now().time_since_epoch().count();
+    chrono::steady_clock::rep last = run.lastProgressReport.load(memory_order_relaxed);
+    chrono::steady_clock::rep interval = chrono::duration_cast<chrono::steady_clock::duration>(PROGRESS_INTERVAL).count();
 
-            totalStartTime += dayStartMinutes;
-            totalEndTime += dayEndMinutes;
+    // Only one search thread reports per interval
+    if (now - last < interval || !run.lastProgressReport.compare_exchange_strong(last, now)) return;
 
-            // Calculate gaps for day
-            for (size_t i = 0; i < scheduleDay.day_items.size() - 1; i++) {
-                int currentEndMinutes = TimeUtils::toMinutes(scheduleDay.day_items[i].end);
-                int nextStartMinutes = TimeUtils::toMinutes(scheduleDay.day_items[i + 1].start);
+    progressCallback(min(explored, 1.0));
+}
 
-                int gapDuration = nextStartMinutes - currentEndMinutes;
+// A search that ran to its end explored the whole tree, budget stops included
+void ScheduleBuilder::finishProgress(BuildRun& run) const {
+    if (progressCallback && !run.stopRequested) {
+        progressCallback(1.0);
+    }
+}
 
-                if (gapDuration >= 30) {
-                    totalGaps++;
-                    totalGapTime += gapDuration;
+// Tells the caller how the run ended, when it asked
+void ScheduleBuilder::recordOutcome(const BuildRun& run, BuildOutcome* outcome) {
+    if (outcome) {
+        *outcome = {run.budgetExhausted, run.stopRequested, run.deliveredCount, run.reusedPrevious};
+    }
+}
+
+// Stops every search, the schedules found so far are kept
+void ScheduleBuilder::exhaustBudget(BuildRun& run, const string& limit) const {
+    if (run.budgetExhausted.exchange(true)) return;
+    Logger::get().logWarning("Schedule generation reached its " + limit + " budget, keeping the schedules found so far");
+}
+
+void ScheduleBuilder::setBudget(const GenerationBudget& generationBudget) {
+    budget = generationBudget;
+}
+
+// Hands the held schedules to the batch callback, numbering them across all batches
+void ScheduleBuilder::deliverBatch(BuildRun& run, ScheduleStore& schedules) const {
+    {
+        lock_guard<mutex> guard(run.deliveryLock);
+        queueBatch(run, schedules);
+    }
+    sendBatches(run);
+}
+
+// Numbers the held schedules and queues them for sendBatches, under deliveryLock
+void ScheduleBuilder::queueBatch(BuildRun& run, ScheduleStore& schedules) const {
+    if (schedules.empty()) return;
+
+    if (run.stopRequested) {
+        schedules.clear();
+        return;
+    }
+
+    ScheduleStore batch(schedules.catalog());
+    std::swap(batch, schedules);
+    batch.setFirstIndex(static_cast<int>(run.deliveredCount));
+    run.deliveredCount += batch.size();
+    run.pendingBatches.push_back(std::move(batch));
+}
+
+// Passes the queued batches to the callback in order, outside deliveryLock. The callback may block on a
+// slow receiver, so a thread finding another one sending leaves its batches to it and goes on searching.
+void ScheduleBuilder::sendBatches(BuildRun& run) const {
+    while (true) {
+        unique_lock<mutex> sending(run.sendLock, try_to_lock);
+        if (!sending.owns_lock()) return;
+
+        while (true) {
+            ScheduleStore batch;
+            {
+                lock_guard<mutex> guard(run.deliveryLock);
+
+                // Batches queued before the receiver stopped the run are not delivered after all
+                while (run.stopRequested && !run.pendingBatches.empty()) {
+                    run.deliveredCount -= run.pendingBatches.front().size();
+                    run.pendingBatches.pop_front();
                 }
+                if (run.pendingBatches.empty()) break;
+
+                batch = std::move(run.pendingBatches.front());
+                run.pendingBatches.pop_front();
+            }
+
+            size_t last = batch.firstIndex() + batch.size();
+            if (!batchCallback(std::move(batch))) {
+                run.stopRequested = true;
+                Logger::get().logInfo("Schedule generation stopped by the batch receiver after " + to_string(last) + " schedules");
             }
         }
+        sending.unlock();
+
+        // A batch queued while this thread was done sending but still held the lock has no sender yet
+        lock_guard<mutex> guard(run.deliveryLock);
+        if (run.pendingBatches.empty()) return;
+    }
+}
+
+void ScheduleBuilder::setCollapseSameTimeOptions(bool collapse) {
+    collapseSameTimes = collapse;
+}
 
-        schedule.amount_days = totalDaysWithItems;
-        schedule.amount_gaps = totalGaps;
-        schedule.gaps_time = totalGapTime;
-
-        // Calculate averages
-        if (totalDaysWithItems > 0) {
-            schedule.avg_start = totalStartTime / totalDaysWithItems;
-            schedule.avg_end = totalEndTime / totalDaysWithItems;
-        } else {
-            schedule.avg_start = 0;
-            schedule.avg_end = 0;
+void ScheduleBuilder::setBlockedTimes(const vector<Session>& blocked) {
+    blockedTimes = blocked;
+}
+
+void ScheduleBuilder::setConstraints(const ScheduleConstraints& limits) {
+    constraints = limits;
+}
+
+void ScheduleBuilder::setCancellation(shared_ptr<const CancellationToken> token) {
+    cancellation = std::move(token);
+}
+
+void ScheduleBuilder::setProgressCallback(ScheduleProgressCallback callback) {
+    progressCallback = std::move(callback);
+}
+
+void ScheduleBuilder::setThreadCount(int count) {
+    threadCount = max(1, count);
+}
+
+void ScheduleBuilder::setBatchCallback(ScheduleBatchCallback callback, size_t size) {
+    batchCallback = std::move(callback);
+    batchSize = size == 0 ? DEFAULT_BATCH_SIZE : size;
+}
+
+// Runs the search over the options of the results' catalog
+void ScheduleBuilder::search(BuildRun& run, const OptionCompatibility& compatibility, ScheduleStore& results) const {
+    const vector<vector<CourseSelection>>& allOptions = results.catalog()->options;
+    OptionMinutes minutes(allOptions);
+    if (constraints.any()) {
+        run.constraintBound = make_unique<ConstraintBound>(allOptions, constraints);
+    }
+
+    if (threadCount > 1 && !allOptions.empty()) {
+        searchInParallel(run, allOptions, compatibility, minutes, results);
+    } else {
+        SearchState state;
+        state.results = ScheduleStore(results.catalog());
+        state.metrics = IncrementalMetrics(&minutes);
+        state.tracksProgress = static_cast<bool>(progressCallback);
+        state.resultCap = run.resultLimit;
+        prepareSearchState(compatibility, state);
+        if (batchCallback) state.flushAt = batchSize;
+
+        backtrack(run, 0, allOptions, compatibility, state);
+        results = std::move(state.results);
+    }
+
+    finishProgress(run);
+}
+
+// Public method to build all possible valid schedules from a list of courses
+ScheduleStore ScheduleBuilder::buildStore(const vector<Course>& courses, BuildOutcome* outcome) const {
+    Logger::get().logInfo("Starting schedule generation for " + to_string(courses.size()) + " courses.");
+
+    ScheduleStore results;
+    BuildRun run;
+
+    try {
+        auto catalog = buildCatalog(run, courses);
+        results = ScheduleStore(catalog);
+        startBudget(run, results.bytesPerSchedule());
+
+        // Compare every pair of options once, the search then only intersects bitsets
+        OptionCompatibility compatibility = buildCompatibility(run, catalog->options);
+        Logger::get().logInfo("Built option compatibility table (" + to_string(compatibility.memoryBytes()) + " bytes)");
+
+        search(run, compatibility, results);
+
+        // Pass on the last, partly filled batch
+        if (batchCallback) {
+            deliverBatch(run, results);
         }
 
+        results.setTruncated(run.budgetExhausted);
+
+        Logger::get().logInfo("Finished schedule generation. Total valid schedules: " + to_string(results.size() + run.deliveredCount) +
+                              (run.budgetExhausted ? " (truncated)" : "") +
+                              " (" + to_string(results.memoryBytes()) + " bytes held)");
     } catch (const exception& e) {
-        Logger::get().logError("Exception in calculateScheduleMetrics: " + string(e.what()));
-        schedule.amount_days = 0;
-        schedule.amount_gaps = 0;
-        schedule.gaps_time = 0;
-        schedule.avg_start = 0;
-        schedule.avg_end = 0;
+        // Log any exceptions that occur during schedule generation
+        Logger::get().logError("Exception in ScheduleBuilder::build: " + string(e.what()));
     }
-}
\ No newline at end of file
+
+    recordOutcome(run, outcome);
+    return results;
+}
+
+vector<InformativeSchedule> ScheduleBuilder::build(const vector<Course>& courses) const {
+    return buildStore(courses).materializeAll();
+}
@@ -0,0 +1,239 @@
+#include "ScheduleBuilder.h"
+
+using namespace std;
+
+// Checks if there is a time conflict between two CourseSelections
+bool ScheduleBuilder::hasConflict(const CourseSelection& a, const CourseSelection& b) {
+    // Both masks cover their sessions exactly, so a shared slot is a shared minute
+    if (a.occupancyExact && b.occupancyExact) {
+        return a.occupancy.intersects(b.occupancy);
+    }
+
+    // Otherwise compare the packed sessions, packing a side that only has its mask
+    SessionIntervals packedA;
+    SessionIntervals packedB;
+    if (a.intervals.empty()) getSessionIntervals(a, packedA);
+    if (b.intervals.empty()) getSessionIntervals(b, packedB);
+
+    return (a.intervals.empty() ? packedA : a.intervals).overlaps(b.intervals.empty() ? packedB : b.intervals);
+}
+
+// Picks the slot grid from the session times: the longest slot every start and end falls on, and the
+// fewest days from Sunday covering every session. Sessions without a time are left to hasConflict.
+OptionCompatibility ScheduleBuilder::buildCompatibility(const vector<vector<CourseSelection>>& options,
+                                                        const CancellationToken* cancellation) {
+    int step = 0;
+    int lastDay = 1;
+
+    for (const auto& courseOptions : options) {
+        for (const auto& option : courseOptions) {
+            for (const Session* session : getSessions(option)) {
+                int start = session->start_minutes;
+                int end = session->end_minutes;
+                if (start < 0 || end < 0) continue;
+
+                step = gcd(step, gcd(start, end));
+                if (session->day_of_week >= 1 && session->day_of_week <= WeekMask::DAYS) {
+                    lastDay = max(lastDay, session->day_of_week);
+                }
+            }
+        }
+    }
+
+    int slotMinutes = WeekMask::SLOT_MINUTES;
+    for (int candidate : {30, 15, 10}) {
+        if (step % candidate == 0) {
+            slotMinutes = candidate;
+            break;
+        }
+    }
+
+    Logger::get().logInfo("Checking option conflicts on " + to_string(slotMinutes) + "-minute slots over " +
+                          to_string(max(lastDay, 5)) + " days");
+
+    if (lastDay <= 5) return compatibilityForDays<5>(slotMinutes, options, cancellation);
+    if (lastDay == 6) return compatibilityForDays<6>(slotMinutes, options, cancellation);
+    return compatibilityForDays<7>(slotMinutes, options, cancellation);
+}
+
+// The table of a build, checked against its cancellation token while it is filled
+OptionCompatibility ScheduleBuilder::buildCompatibility(BuildRun& run, const vector<vector<CourseSelection>>& options) const {
+    OptionCompatibility compatibility = buildCompatibility(options, cancellation.get());
+    checkCancellation(run);
+    return compatibility;
+}
+
+template <int Days>
+OptionCompatibility ScheduleBuilder::compatibilityForDays(int slotMinutes, const vector<vector<CourseSelection>>& options,
+                                                          const CancellationToken* cancellation) {
+    switch (slotMinutes) {
+        case 30: return compatibilityOn<SlotMask<30, Days>>(options, cancellation);
+        case 15: return compatibilityOn<SlotMask<15, Days>>(options, cancellation);
+        case 10: return compatibilityOn<SlotMask<10, Days>>(options, cancellation);
+        default: return compatibilityOn<SlotMask<5, Days>>(options, cancellation);
+    }
+}
+
+// Masks every option on the grid once; a pair where either option does not fit it exactly goes through hasConflict.
+// Once cancelled the remaining pairs are left conflicting, the search that would use them does not run.
+template <typename Mask>
+OptionCompatibility ScheduleBuilder::compatibilityOn(const vector<vector<CourseSelection>>& options,
+                                                     const CancellationToken* cancellation) {
+    vector<int> counts;
+    vector<vector<Mask>> masks(options.size());
+    vector<vector<char>> exact(options.size());
+
+    for (size_t course = 0; course < options.size(); course++) {
+        counts.push_back(static_cast<int>(options[course].size()));
+
+        for (const auto& option : options[course]) {
+            Mask mask;
+            bool fits = true;
+            for (const Session* session : getSessions(option)) {
+                fits = mask.addSession(*session) && fits;
+            }
+            masks[course].push_back(mask);
+            exact[course].push_back(fits ? 1 : 0);
+        }
+    }
+
+    return OptionCompatibility(counts, [&](int course, int option, int otherCourse, int otherOption) {
+        if (cancellation && cancellation->isCancelled()) return true;
+        if (exact[course][option] && exact[otherCourse][otherOption]) {
+            return masks[course][option].intersects(masks[otherCourse][otherOption]);
+        }
+        return hasConflict(options[course][option], options[otherCourse][otherOption]);
+    });
+}
+
+// Copies the courses into a catalog and generates the legal options of each one.
+// Options overlapping a blocked time or starting too early are dropped here, so the search never sees them.
+// A cancelled build stops generating, the courses left get no options.
+shared_ptr<ScheduleCatalog> ScheduleBuilder::buildCatalog(BuildRun& run, const vector<Course>& courses) const {
+    // The catalog keeps its own copy of the courses, results outlive the caller's vector
+    auto catalog = make_shared<ScheduleCatalog>();
+    catalog->courses = courses;
+    catalog->blockedTimes = blockedTimes;
+    catalog->constraints = constraints;
+    buildCourseInfoMap(catalog->courses, catalog->courseInfo);
+
+    // The blocked times as one selection, checked against each option like another course would be.
+    // Times before the earliest start are blocked the same way.
+    Group blockedGroup{SessionType::BLOCK, blockedTimes};
+    vector<Session> early = ConstraintBound::earlyTimes(constraints);
+    blockedGroup.sessions.insert(blockedGroup.sessions.end(), early.begin(), early.end());
+    CourseSelection blocked{0, nullptr, nullptr, nullptr, &blockedGroup};
+    CourseLegalComb::computeOccupancy(blocked);
+
+    CourseLegalComb generator;
+    vector<vector<EquivalentGroups>> equivalents(catalog->courses.size());
+
+    // Generate combinations for each course, groups with the same times only once when collapsing
+    for (size_t index = 0; index < catalog->courses.size(); index++) {
+        if (checkCancellation(run)) break;
+
+        const Course& course = catalog->courses[index];
+        auto combinations = collapseSameTimes ? generator.generateDistinct(course, equivalents[index])
+                                              : generator.generate(course);
+        size_t generated = combinations.size();
+
+        if (!blockedGroup.sessions.empty()) {
+            size_t kept = 0;
+            for (size_t option = 0; option < combinations.size(); option++) {
+                if (hasConflict(combinations[option], blocked)) continue;
+                combinations[kept] = combinations[option];
+                if (collapseSameTimes) equivalents[index][kept] = std::move(equivalents[index][option]);
+                kept++;
+            }
+            combinations.resize(kept);
+            if (collapseSameTimes) equivalents[index].resize(kept);
+        }
+
+        Logger::get().logInfo("Generated " + to_string(generated) + " combinations for course ID " + to_string(course.id) +
+                              (generated != combinations.size()
+                               ? ", " + to_string(generated - combinations.size()) + " of them overlap blocked times or start too early"
+                               : ""));
+        catalog->options.push_back(std::move(combinations)); // Store the combinations
+    }
+    catalog->options.resize(catalog->courses.size());
+
+    if (collapseSameTimes) {
+        collapseSameTimeOptions(*catalog, equivalents);
+    }
+
+    return catalog;
+}
+
+// Options of a course with exactly the same sessions times conflict with the same options of every other
+// course and give the same metrics, so only the first of them is searched. The rest are kept as its variants:
+// first every swap of equivalent groups, then other options that end up with the same times.
+void ScheduleBuilder::collapseSameTimeOptions(ScheduleCatalog& catalog,
+                                              const vector<vector<EquivalentGroups>>& equivalents) {
+    catalog.variants.assign(catalog.options.size(), {});
+
+    for (size_t course = 0; course < catalog.options.size(); course++) {
+        vector<CourseSelection>& options = catalog.options[course];
+        vector<CourseSelection> distinct;
+        vector<vector<CourseSelection>>& variants = catalog.variants[course];
+        map<vector<tuple<int, int, int>>, size_t> classes;
+        size_t combinations = 0;
+
+        for (size_t index = 0; index < options.size(); index++) {
+            const CourseSelection& option = options[index];
+            vector<CourseSelection> swaps = expandEquivalentGroups(option, equivalents[course][index]);
+            combinations += swaps.size();
+
+            vector<tuple<int, int, int>> times;
+            for (const Session* session : getSessions(option)) {
+                times.emplace_back(session->day_of_week, session->start_minutes, session->end_minutes);
+            }
+            sort(times.begin(), times.end());
+
+            auto known = classes.find(times);
+            if (known != classes.end()) {
+                vector<CourseSelection>& same = variants[known->second];
+                same.insert(same.end(), swaps.begin(), swaps.end());
+                continue;
+            }
+
+            classes.emplace(std::move(times), distinct.size());
+            distinct.push_back(option);
+            variants.push_back(std::move(swaps));
+        }
+
+        if (distinct.size() != combinations) {
+            Logger::get().logInfo("Collapsed " + to_string(combinations) + " combinations of course ID " +
+                                  to_string(catalog.courses[course].id) + " into " + to_string(distinct.size()) +
+                                  " with distinct times");
+        }
+        options = std::move(distinct);
+    }
+}
+
+// Every combination made by switching the groups of option for equivalent ones, option itself first
+vector<CourseSelection> ScheduleBuilder::expandEquivalentGroups(const CourseSelection& option,
+                                                                const EquivalentGroups& equivalent) {
+    vector<CourseSelection> swaps;
+    swaps.reserve(equivalent.lectures.size() * equivalent.tutorials.size() * equivalent.labs.size());
+
+    for (const Group* lecture : equivalent.lectures) {
+        for (const Group* tutorial : equivalent.tutorials) {
+            for (const Group* lab : equivalent.labs) {
+                CourseSelection swap = option;
+                swap.lectureGroup = lecture;
+                swap.tutorialGroup = tutorial;
+                swap.labGroup = lab;
+                swaps.push_back(swap);
+            }
+        }
+    }
+    return swaps;
+}
+
+// Helper method to build course info map
+void ScheduleBuilder::buildCourseInfoMap(const vector<Course>& courses, unordered_map<int, CourseInfo>& courseInfo) {
+    courseInfo.clear();
+    for (const auto& course : courses) {
+        courseInfo[course.id] = {course.raw_id, course.name};
+    }
+}
@@ -0,0 +1,236 @@
+#include "ScheduleBuilder.h"
+
+using namespace std;
+
+size_t ScheduleBuilder::countSchedules(const vector<Course>& courses, BuildOutcome* outcome) const {
+    Logger::get().logInfo("Counting schedules for " + to_string(courses.size()) + " courses.");
+
+    size_t count = 0;
+    BuildRun run;
+
+    try {
+        auto catalog = buildCatalog(run, courses);
+        OptionCompatibility compatibility = buildCompatibility(run, catalog->options);
+        startBudget(run, 0);
+
+        SearchState state;
+        prepareSearchState(compatibility, state);
+
+        // The earliest start is already applied to the options, the other limits depend on the options chosen
+        if (constraints.limitsMetrics()) {
+            OptionMinutes minutes(catalog->options);
+            state.metrics = IncrementalMetrics(&minutes);
+            run.constraintBound = make_unique<ConstraintBound>(catalog->options, constraints);
+            run.countOnly = true;
+
+            backtrack(run, 0, catalog->options, compatibility, state);
+            count = state.found;
+
+            Logger::get().logInfo("Finished counting. Total valid schedules meeting the constraints: " + to_string(count));
+        } else {
+            CountMemo memo;
+            count = countCompletions(run, 0, compatibility, state, memo);
+
+            Logger::get().logInfo("Finished counting. Total valid schedules: " + to_string(count) +
+                                  " (" + to_string(memo.size()) + " subtrees remembered)");
+        }
+    } catch (const exception& e) {
+        Logger::get().logError("Exception in ScheduleBuilder::countSchedules: " + string(e.what()));
+    }
+
+    recordOutcome(run, outcome);
+    return count;
+}
+
+// Same walk as backtrack without building anything. Subtrees that leave the open courses
+// the same options have the same count, so it is computed once per distinct set of domains.
+size_t ScheduleBuilder::countCompletions(BuildRun& run,
+                                         int depth,
+                                         const OptionCompatibility& compatibility,
+                                         SearchState& state,
+                                         CountMemo& memo) const {
+    if (run.stopRequested.load(memory_order_relaxed) || run.budgetExhausted.load(memory_order_relaxed)) return 0;
+    if (checkpoint(run, state)) return 0;
+
+    const vector<uint64_t>& domains = state.domainsByLevel[depth];
+
+    if (state.openCourses.empty()) return 1;
+
+    // Forward checking left the last course only options that fit every chosen one
+    if (state.openCourses.size() == 1) {
+        return compatibility.remainingOptions(state.openCourses.front(), domains.data());
+    }
+
+    vector<uint64_t> key;
+    for (int course : state.openCourses) {
+        key.push_back(course);
+        size_t offset = compatibility.domainOffset(course);
+        key.insert(key.end(), domains.begin() + offset, domains.begin() + offset + compatibility.wordCount(course));
+    }
+
+    auto known = memo.find(key);
+    if (known != memo.end()) return known->second;
+
+    vector<uint64_t>& nextDomains = state.domainsByLevel[depth + 1];
+
+    size_t position = selectCourse(compatibility, state.openCourses, domains);
+    int course = state.openCourses[position];
+    state.openCourses.erase(state.openCourses.begin() + position);
+
+    size_t count = 0;
+    size_t offset = compatibility.domainOffset(course);
+    for (int word = 0; word < compatibility.wordCount(course); word++) {
+        uint64_t remaining = domains[offset + word];
+
+        while (remaining) {
+            int option = word * 64 + OptionCompatibility::lowestSetBit(remaining);
+            remaining &= remaining - 1;
+
+            if (compatibility.narrowDomains(course, option, state.openCourses, domains.data(), nextDomains.data())) {
+                count += countCompletions(run, depth + 1, compatibility, state, memo);
+            }
+        }
+    }
+
+    state.openCourses.insert(state.openCourses.begin() + position, course);
+
+    // A count cut short by the budget is only a lower bound
+    if (!run.budgetExhausted && memo.size() < MAX_COUNT_MEMO_ENTRIES) {
+        memo.emplace(std::move(key), count);
+    }
+    return count;
+}
+
+ScheduleStore ScheduleBuilder::sampleSchedules(const vector<Course>& courses, size_t count, uint64_t seed,
+                                               BuildOutcome* outcome) const {
+    Logger::get().logInfo("Sampling " + to_string(count) + " schedules for " + to_string(courses.size()) + " courses.");
+
+    ScheduleStore results;
+    BuildRun run;
+
+    if (count == 0) {
+        recordOutcome(run, outcome);
+        return results;
+    }
+
+    // Ranks are found from counts of whole subtrees, which limits on the metrics split
+    if (constraints.limitsMetrics()) {
+        Logger::get().logError("Samples can only be limited by the earliest start, none sampled");
+        recordOutcome(run, outcome);
+        return results;
+    }
+
+    try {
+        auto catalog = buildCatalog(run, courses);
+        results = ScheduleStore(catalog);
+        OptionCompatibility compatibility = buildCompatibility(run, catalog->options);
+        startBudget(run, results.bytesPerSchedule());
+
+        // The counts of the subtrees stay in the memo, every draw walks down the same tree
+        SearchState state;
+        prepareSearchState(compatibility, state);
+        CountMemo memo;
+        size_t total = countCompletions(run, 0, compatibility, state, memo);
+
+        // A count cut short is only a lower bound, ranks cannot be found from it
+        vector<size_t> ranks;
+        if (run.budgetExhausted || run.stopRequested) {
+            Logger::get().logInfo("Too many schedules to count, none sampled");
+        } else {
+            ranks = sampleRanks(total, count, seed);
+        }
+
+        OptionMinutes minutes(catalog->options);
+        for (size_t rank : ranks) {
+            if (!unrankSchedule(run, rank, compatibility, state, memo)) break;
+
+            IncrementalMetrics metrics(&minutes);
+            for (int course = 0; course < compatibility.courseCount(); course++) {
+                metrics.add(course, state.chosenOptions[course]);
+            }
+            results.add(state.chosenOptions, metrics.metrics());
+        }
+        results.setTruncated(run.budgetExhausted);
+
+        Logger::get().logInfo("Finished sampling. Drew " + to_string(results.size()) + " of " + to_string(total) + " schedules");
+    } catch (const exception& e) {
+        Logger::get().logError("Exception in ScheduleBuilder::sampleSchedules: " + string(e.what()));
+    }
+
+    recordOutcome(run, outcome);
+    return results;
+}
+
+// Takes at every level the option whose subtree holds the rank, skipping the schedules of the options before it
+bool ScheduleBuilder::unrankSchedule(BuildRun& run,
+                                     size_t rank,
+                                     const OptionCompatibility& compatibility,
+                                     SearchState& state,
+                                     CountMemo& memo) const {
+    prepareSearchState(compatibility, state);
+
+    for (int depth = 0; !state.openCourses.empty(); depth++) {
+        const vector<uint64_t>& domains = state.domainsByLevel[depth];
+        vector<uint64_t>& nextDomains = state.domainsByLevel[depth + 1];
+
+        size_t position = selectCourse(compatibility, state.openCourses, domains);
+        int course = state.openCourses[position];
+        state.openCourses.erase(state.openCourses.begin() + position);
+
+        size_t offset = compatibility.domainOffset(course);
+        for (int word = 0; word < compatibility.wordCount(course) && state.chosenOptions[course] < 0; word++) {
+            uint64_t remaining = domains[offset + word];
+
+            while (remaining) {
+                int option = word * 64 + OptionCompatibility::lowestSetBit(remaining);
+                remaining &= remaining - 1;
+
+                if (!compatibility.narrowDomains(course, option, state.openCourses, domains.data(), nextDomains.data())) {
+                    continue;
+                }
+
+                // Counting leaves nextDomains as it is, only deeper levels are used
+                size_t below = countCompletions(run, depth + 1, compatibility, state, memo);
+                if (run.budgetExhausted || run.stopRequested) return false;
+
+                if (rank < below) {
+                    state.chosenOptions[course] = option;
+                    break;
+                }
+                rank -= below;
+            }
+        }
+
+        if (state.chosenOptions[course] < 0) return false;
+    }
+    return true;
+}
+
+vector<size_t> ScheduleBuilder::sampleRanks(size_t total, size_t count, uint64_t seed) {
+    vector<size_t> ranks;
+    if (count >= total) {
+        ranks.resize(total);
+        iota(ranks.begin(), ranks.end(), 0);
+        return ranks;
+    }
+
+    // Each step draws from one more rank, taking the new one when the draw was taken already
+    mt19937_64 random(seed);
+    unordered_set<size_t> chosen;
+    for (size_t last = total - count; last < total; last++) {
+        size_t drawn = uniform_int_distribution<size_t>(0, last)(random);
+        if (!chosen.insert(drawn).second) chosen.insert(last);
+    }
+
+    ranks.assign(chosen.begin(), chosen.end());
+    sort(ranks.begin(), ranks.end());
+    return ranks;
+}
+
+size_t ScheduleBuilder::DomainsHash::operator()(const vector<uint64_t>& key) const {
+    size_t hash = key.size();
+    for (uint64_t word : key) {
+        hash ^= std::hash<uint64_t>()(word) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
@@ -0,0 +1,111 @@
+#include "ScheduleBuilder.h"
+
+using namespace std;
+
+ScheduleStore ScheduleBuilder::buildParetoFront(const vector<Course>& courses,
+                                                const vector<ScheduleObjective>& objectives,
+                                                BuildOutcome* outcome) const {
+    Logger::get().logInfo("Starting generation of the Pareto-optimal schedules over " + to_string(objectives.size()) +
+                          " objectives for " + to_string(courses.size()) + " courses.");
+
+    ScheduleStore results;
+    BuildRun run;
+
+    if (objectives.empty()) {
+        Logger::get().logError("No objectives to compare schedules by, aborting...");
+        recordOutcome(run, outcome);
+        return results;
+    }
+
+    try {
+        auto catalog = buildCatalog(run, courses);
+        results = ScheduleStore(catalog);
+        startBudget(run, 0);
+
+        OptionCompatibility compatibility = buildCompatibility(run, catalog->options);
+        vector<ObjectiveBound> bounds;
+        for (const auto& objective : objectives) {
+            bounds.emplace_back(catalog->options, objective);
+        }
+        run.pareto = make_unique<ParetoState>(std::move(bounds));
+
+        // Complete schedules only go to the front, results stays empty during the search
+        search(run, compatibility, results);
+
+        auto& front = run.pareto->front;
+        sort(front.begin(), front.end(), [](const ParetoPoint& a, const ParetoPoint& b) {
+            return tie(a.scores, a.searchOrder) < tie(b.scores, b.searchOrder);
+        });
+        for (const auto& point : front) {
+            results.add(point.options, point.metrics);
+        }
+        results.setTruncated(run.budgetExhausted);
+
+        Logger::get().logInfo("Finished schedule generation. Kept " + to_string(results.size()) + " Pareto-optimal schedules");
+    } catch (const exception& e) {
+        Logger::get().logError("Exception in ScheduleBuilder::buildParetoFront: " + string(e.what()));
+    }
+
+    recordOutcome(run, outcome);
+    return results;
+}
+
+ScheduleBuilder::ParetoState::ParetoState(vector<ObjectiveBound> objectiveBounds) : bounds(std::move(objectiveBounds)) {
+    for (const auto& bound : bounds) {
+        canPrune = canPrune || bound.canPrune();
+    }
+}
+
+// Adds a schedule to the front unless a schedule on it covers it, dropping the ones it covers
+void ScheduleBuilder::offerPareto(BuildRun& run, const SearchState& state, const ScheduleMetrics& metrics) const {
+    ParetoPoint candidate{{}, {state.task, state.sequence}, state.chosenOptions, metrics};
+    for (const auto& bound : run.pareto->bounds) {
+        candidate.scores.push_back(bound.score(metrics));
+    }
+
+    auto& front = run.pareto->front;
+
+    lock_guard<mutex> guard(run.pareto->lock);
+    for (const auto& point : front) {
+        if (covers(point, candidate.scores, candidate.searchOrder)) return;
+    }
+
+    front.erase(remove_if(front.begin(), front.end(), [&](const ParetoPoint& point) {
+        return covers(candidate, point.scores, point.searchOrder);
+    }), front.end());
+    front.push_back(std::move(candidate));
+    run.pareto->version++;
+}
+
+// Every completion scores at least the lower bounds, so a schedule covering the bounds covers them all.
+// Schedules found later in search order than the current node cannot be found by it.
+bool ScheduleBuilder::paretoCovered(BuildRun& run, SearchState& state) {
+    ParetoState& pareto = *run.pareto;
+
+    if (pareto.version.load(memory_order_acquire) != state.paretoVersion) {
+        lock_guard<mutex> guard(pareto.lock);
+        state.paretoFront = pareto.front;
+        state.paretoVersion = pareto.version.load(memory_order_relaxed);
+    }
+    if (state.paretoFront.empty()) return false;
+
+    vector<int> bounds;
+    for (const auto& bound : pareto.bounds) {
+        bounds.push_back(bound.canPrune() ? bound.lowerBound(state.chosenOptions) : INT_MIN);
+    }
+
+    pair<size_t, size_t> searchOrder{state.task, state.sequence};
+    for (const auto& point : state.paretoFront) {
+        if (covers(point, bounds, searchOrder)) return true;
+    }
+    return false;
+}
+
+bool ScheduleBuilder::covers(const ParetoPoint& point, const vector<int>& scores, const pair<size_t, size_t>& searchOrder) {
+    bool better = false;
+    for (size_t objective = 0; objective < scores.size(); objective++) {
+        if (point.scores[objective] > scores[objective]) return false;
+        better = better || point.scores[objective] < scores[objective];
+    }
+    return better || point.searchOrder < searchOrder;
+}
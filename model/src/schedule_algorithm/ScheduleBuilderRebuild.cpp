@@ -0,0 +1,240 @@
+#include "ScheduleBuilder.h"
+
+using namespace std;
+
+// Reuses previous when it holds every schedule of the same courses without one of them, under the same blocked times:
+// each previous schedule is extended by the options of the added course that fit it, so nothing
+// is searched again. Any other change of the courses runs the full search. Dropping a course cannot
+// reuse previous, schedules the dropped course ruled out would be missing from a projection.
+// Constraints also run the full search, a schedule may meet them while its projection does not.
+ScheduleStore ScheduleBuilder::rebuildStore(const ScheduleStore& previous, const vector<Course>& courses,
+                                            BuildOutcome* outcome) const {
+    vector<int> previousCourse;
+    int added = -1;
+    if (!previous.catalog() || previous.truncated() ||
+        !sameSessions(previous.catalog()->blockedTimes, blockedTimes) ||
+        previous.catalog()->variants.empty() == collapseSameTimes ||
+        previous.catalog()->constraints.any() || constraints.any() ||
+        !matchPreviousCourses(previous.catalog()->courses, courses, previousCourse, added)) {
+        return buildStore(courses, outcome);
+    }
+
+    Logger::get().logInfo("Extending " + to_string(previous.size()) + " previous schedules by course ID " +
+                          to_string(courses[added].id));
+
+    ScheduleStore results;
+    BuildRun run;
+
+    try {
+        auto catalog = buildCatalog(run, courses);
+        results = ScheduleStore(catalog);
+        startBudget(run, results.bytesPerSchedule());
+
+        const vector<vector<CourseSelection>>& allOptions = catalog->options;
+        const vector<CourseSelection>& addedOptions = allOptions[added];
+        size_t addedWords = (addedOptions.size() + 63) / 64;
+
+        // fits[course][option] marks the options of the added course that do not conflict with it
+        vector<vector<vector<uint64_t>>> fits(courses.size());
+        for (size_t course = 0; course < courses.size(); course++) {
+            if (static_cast<int>(course) == added) continue;
+
+            for (const auto& option : allOptions[course]) {
+                vector<uint64_t> bits(addedWords, 0);
+                for (size_t other = 0; other < addedOptions.size(); other++) {
+                    if (!hasConflict(option, addedOptions[other])) bits[other / 64] |= 1ULL << (other % 64);
+                }
+                fits[course].push_back(std::move(bits));
+            }
+        }
+
+        // Schedules are held back until they are in search order, a search with more than the result
+        // budget keeps the first ones in that order, which the extension cannot tell
+        OptionMinutes minutes(allOptions);
+        SearchState state;
+        state.results = ScheduleStore(catalog);
+        state.metrics = IncrementalMetrics(&minutes);
+        state.chosenOptions.assign(courses.size(), -1);
+        state.resultCap = run.resultLimit;
+        state.limitEndsSearch = false;
+        state.tracksProgress = static_cast<bool>(progressCallback);
+
+        vector<uint64_t> candidates(addedWords);
+        for (size_t position = 0; position < previous.size(); position++) {
+            state.explored = static_cast<double>(position) / previous.size();
+            if (run.stopRequested || run.budgetExhausted || state.full || checkpoint(run, state)) break;
+
+            fill(candidates.begin(), candidates.end(), ~0ULL);
+            if (addedOptions.size() % 64 != 0) candidates.back() = (1ULL << (addedOptions.size() % 64)) - 1;
+
+            for (size_t course = 0; course < courses.size(); course++) {
+                if (static_cast<int>(course) == added) continue;
+
+                // Consecutive schedules mostly share options, only the changed ones are swapped
+                int option = static_cast<int>(previous.option(position, previousCourse[course]));
+                if (state.chosenOptions[course] != option) {
+                    if (state.chosenOptions[course] >= 0) state.metrics.remove(static_cast<int>(course), state.chosenOptions[course]);
+                    state.metrics.add(static_cast<int>(course), option);
+                    state.chosenOptions[course] = option;
+                }
+                OptionCompatibility::intersect(candidates.data(), fits[course][option].data(), static_cast<int>(addedWords));
+            }
+
+            for (size_t word = 0; word < addedWords; word++) {
+                uint64_t remaining = candidates[word];
+
+                while (remaining) {
+                    int option = static_cast<int>(word * 64) + OptionCompatibility::lowestSetBit(remaining);
+                    remaining &= remaining - 1;
+
+                    state.chosenOptions[added] = option;
+                    state.metrics.add(added, option);
+                    completeSchedule(run, state);
+                    state.metrics.remove(added, option);
+                }
+            }
+        }
+
+        if (state.full) {
+            Logger::get().logInfo("The extended schedules exceed the result budget, searching instead");
+            return buildStore(courses, outcome);
+        }
+
+        // Numbered as a fresh build would number them
+        ScheduleStore extended = std::move(state.results);
+        OptionCompatibility compatibility = buildCompatibility(run, allOptions);
+        for (size_t position : orderLikeSearch(compatibility, extended)) {
+            results.addFrom(extended, position);
+            if (batchCallback && results.size() >= batchSize) {
+                deliverBatch(run, results);
+            }
+        }
+        run.reusedPrevious = true;
+
+        finishProgress(run);
+        if (batchCallback) {
+            deliverBatch(run, results);
+        }
+        results.setTruncated(run.budgetExhausted);
+
+        Logger::get().logInfo("Finished schedule generation. Total valid schedules: " + to_string(results.size() + run.deliveredCount) +
+                              (run.budgetExhausted ? " (truncated)" : ""));
+    } catch (const exception& e) {
+        Logger::get().logError("Exception in ScheduleBuilder::rebuildStore: " + string(e.what()));
+    }
+
+    recordOutcome(run, outcome);
+    return results;
+}
+
+// Positions of the schedules in the order the search meets them: at every level the course the search
+// takes next, then its options in order. Schedules sharing an option are ordered below it the same way.
+vector<size_t> ScheduleBuilder::orderLikeSearch(const OptionCompatibility& compatibility, const ScheduleStore& schedules) {
+    size_t courseCount = static_cast<size_t>(compatibility.courseCount());
+    vector<uint32_t> options(schedules.size() * courseCount);
+    for (size_t position = 0; position < schedules.size(); position++) {
+        for (size_t course = 0; course < courseCount; course++) {
+            options[position * courseCount + course] = schedules.option(position, course);
+        }
+    }
+
+    vector<size_t> order(schedules.size());
+    iota(order.begin(), order.end(), 0);
+
+    SearchState state;
+    prepareSearchState(compatibility, state);
+    orderLevel(compatibility, options, 0, order.begin(), order.end(), state);
+    return order;
+}
+
+void ScheduleBuilder::orderLevel(const OptionCompatibility& compatibility,
+                                 const vector<uint32_t>& options,
+                                 int depth,
+                                 vector<size_t>::iterator first,
+                                 vector<size_t>::iterator last,
+                                 SearchState& state) {
+    if (state.openCourses.empty() || last - first <= 1) return;
+
+    const vector<uint64_t>& domains = state.domainsByLevel[depth];
+    vector<uint64_t>& nextDomains = state.domainsByLevel[depth + 1];
+
+    size_t position = selectCourse(compatibility, state.openCourses, domains);
+    int course = state.openCourses[position];
+    state.openCourses.erase(state.openCourses.begin() + position);
+
+    size_t courseCount = static_cast<size_t>(compatibility.courseCount());
+    auto optionOf = [&](size_t schedule) { return options[schedule * courseCount + course]; };
+    stable_sort(first, last, [&](size_t a, size_t b) { return optionOf(a) < optionOf(b); });
+
+    for (auto group = first; group != last;) {
+        uint32_t option = optionOf(*group);
+        auto groupEnd = find_if(group, last, [&](size_t schedule) { return optionOf(schedule) != option; });
+
+        // The schedules are valid, so their options leave every open course an option
+        compatibility.narrowDomains(course, static_cast<int>(option), state.openCourses, domains.data(), nextDomains.data());
+        orderLevel(compatibility, options, depth + 1, group, groupEnd, state);
+        group = groupEnd;
+    }
+
+    state.openCourses.insert(state.openCourses.begin() + position, course);
+}
+
+// Pairs every course with the same course of the previous run. Succeeds when exactly one course is new.
+bool ScheduleBuilder::matchPreviousCourses(const vector<Course>& previousCourses,
+                                           const vector<Course>& courses,
+                                           vector<int>& previousCourse,
+                                           int& added) {
+    if (courses.size() != previousCourses.size() + 1) return false;
+
+    previousCourse.assign(courses.size(), -1);
+    vector<char> matched(previousCourses.size(), 0);
+    added = -1;
+
+    for (size_t course = 0; course < courses.size(); course++) {
+        for (size_t candidate = 0; candidate < previousCourses.size(); candidate++) {
+            if (!matched[candidate] && sameCourse(courses[course], previousCourses[candidate])) {
+                matched[candidate] = 1;
+                previousCourse[course] = static_cast<int>(candidate);
+                break;
+            }
+        }
+
+        if (previousCourse[course] >= 0) continue;
+        if (added >= 0) return false;
+        added = static_cast<int>(course);
+    }
+    return added >= 0;
+}
+
+// Same id and the same sessions in the same groups, so the course yields the same options in the same order
+bool ScheduleBuilder::sameCourse(const Course& a, const Course& b) {
+    auto sameGroups = [](const vector<Group>& first, const vector<Group>& second) {
+        if (first.size() != second.size()) return false;
+
+        for (size_t group = 0; group < first.size(); group++) {
+            if (first[group].type != second[group].type || !sameSessions(first[group].sessions, second[group].sessions)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    return a.id == b.id && a.raw_id == b.raw_id && a.name == b.name &&
+           sameGroups(a.Lectures, b.Lectures) && sameGroups(a.Tirgulim, b.Tirgulim) &&
+           sameGroups(a.labs, b.labs) && sameGroups(a.blocks, b.blocks);
+}
+
+bool ScheduleBuilder::sameSessions(const vector<Session>& a, const vector<Session>& b) {
+    if (a.size() != b.size()) return false;
+
+    for (size_t session = 0; session < a.size(); session++) {
+        if (a[session].day_of_week != b[session].day_of_week ||
+            a[session].start_minutes != b[session].start_minutes ||
+            a[session].end_minutes != b[session].end_minutes ||
+            a[session].building_number != b[session].building_number ||
+            a[session].room_number != b[session].room_number) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,66 @@
+#include "ScheduleBuilder.h"
+
+using namespace std;
+
+ScheduleStore ScheduleBuilder::buildTopK(const vector<Course>& courses, const ScheduleObjective& objective, size_t k,
+                                         BuildOutcome* outcome) const {
+    Logger::get().logInfo("Starting generation of the " + to_string(k) + " best schedules for " + to_string(courses.size()) + " courses.");
+
+    ScheduleStore results;
+    BuildRun run;
+
+    if (k == 0) {
+        recordOutcome(run, outcome);
+        return results;
+    }
+
+    try {
+        auto catalog = buildCatalog(run, courses);
+        results = ScheduleStore(catalog);
+        startBudget(run, 0);
+
+        OptionCompatibility compatibility = buildCompatibility(run, catalog->options);
+        run.topK = make_unique<TopKState>(k, ObjectiveBound(catalog->options, objective));
+
+        // Complete schedules only go to the heap, results stays empty during the search
+        search(run, compatibility, results);
+
+        sort(run.topK->heap.begin(), run.topK->heap.end());
+        for (const auto& ranked : run.topK->heap) {
+            results.add(ranked.options, ranked.metrics);
+        }
+        results.setTruncated(run.budgetExhausted);
+
+        Logger::get().logInfo("Finished schedule generation. Kept the best " + to_string(results.size()) + " schedules");
+    } catch (const exception& e) {
+        Logger::get().logError("Exception in ScheduleBuilder::buildTopK: " + string(e.what()));
+    }
+
+    recordOutcome(run, outcome);
+    return results;
+}
+
+// Adds a schedule to the k best when it beats the current k-th best
+void ScheduleBuilder::offerTopK(BuildRun& run, const SearchState& state, const ScheduleMetrics& metrics) const {
+    int score = run.topK->bound.score(metrics);
+    if (score > run.topK->worstScore.load(memory_order_relaxed)) return;
+
+    RankedSchedule candidate{score, {state.task, state.sequence}, state.chosenOptions, metrics};
+    auto& heap = run.topK->heap;
+
+    lock_guard<mutex> guard(run.topK->lock);
+    if (heap.size() < run.topK->k) {
+        heap.push_back(std::move(candidate));
+        push_heap(heap.begin(), heap.end());
+    } else if (candidate < heap.front()) {
+        pop_heap(heap.begin(), heap.end());
+        heap.back() = std::move(candidate);
+        push_heap(heap.begin(), heap.end());
+    } else {
+        return;
+    }
+
+    if (heap.size() == run.topK->k) {
+        run.topK->worstScore = heap.front().score;
+    }
+}
@@ -0,0 +1,170 @@
+#include "ScheduleRanking.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+using namespace std;
+
+void ScheduleRanking::assign(const ScheduleStore& schedules) {
+    for (auto& values : metrics) values.clear();
+    scores.clear();
+    isRanked = false;
+    sorted = 0;
+    vector<size_t> order;
+    append(schedules, order);
+}
+
+bool ScheduleRanking::append(const ScheduleStore& schedules, vector<size_t>& order) {
+    size_t first = scores.size();
+    size_t count = schedules.size();
+    if (first >= count) return false;
+
+    for (auto& values : metrics) values.reserve(count);
+    for (size_t position = first; position < count; position++) {
+        ScheduleMetrics scheduleMetrics = schedules.metrics(position);
+        metrics[static_cast<int>(ScheduleMetric::AMOUNT_DAYS)].push_back(scheduleMetrics.amount_days);
+        metrics[static_cast<int>(ScheduleMetric::AMOUNT_GAPS)].push_back(scheduleMetrics.amount_gaps);
+        metrics[static_cast<int>(ScheduleMetric::GAPS_TIME)].push_back(scheduleMetrics.gaps_time);
+        metrics[static_cast<int>(ScheduleMetric::AVG_START)].push_back(scheduleMetrics.avg_start);
+        metrics[static_cast<int>(ScheduleMetric::AVG_END)].push_back(scheduleMetrics.avg_end);
+    }
+
+    scores.resize(count);
+    order.resize(count);
+    iota(order.begin() + first, order.end(), first);
+
+    bool widened = widenRanges(first);
+    if (!isRanked) return false;
+
+    // Scaled values of every schedule moved, the sorted part is sorted again
+    if (widened) {
+        score(0);
+        size_t keep = sorted;
+        sorted = 0;
+        sortUpTo(order, keep);
+        return keep > 0;
+    }
+
+    score(first);
+    if (sorted == 0) return false;
+
+    const float* values = scores.data();
+    auto before = [values](size_t a, size_t b) {
+        return values[a] < values[b] || (values[a] == values[b] && a < b);
+    };
+
+    // New schedules beating the last sorted one are merged into the sorted part, pushing as many of its
+    // last ones into the unsorted rest where the new schedules were
+    size_t worst = order[sorted - 1];
+    vector<size_t> better;
+    for (size_t position = first; position < count; position++) {
+        if (before(position, worst)) better.push_back(position);
+    }
+    if (better.empty()) return false;
+    sort(better.begin(), better.end(), before);
+
+    vector<size_t> merged;
+    merged.reserve(sorted + better.size());
+    merge(order.begin(), order.begin() + sorted, better.begin(), better.end(), back_inserter(merged), before);
+
+    copy(merged.begin(), merged.begin() + sorted, order.begin());
+    auto rest = copy(merged.begin() + sorted, merged.end(), order.begin() + first);
+    for (size_t position = first; position < count; position++) {
+        if (!before(position, worst)) *rest++ = position;
+    }
+    return true;
+}
+
+void ScheduleRanking::rank(const Weights& rankWeights, vector<size_t>& order, size_t count) {
+    weights = rankWeights;
+    isRanked = true;
+    score(0);
+
+    order.resize(scores.size());
+    iota(order.begin(), order.end(), 0);
+    sorted = 0;
+    sortUpTo(order, count);
+}
+
+void ScheduleRanking::sortUpTo(vector<size_t>& order, size_t count) {
+    count = min(count, order.size());
+    if (!isRanked || count <= sorted) return;
+
+    const float* values = scores.data();
+    auto before = [values](size_t a, size_t b) {
+        return values[a] < values[b] || (values[a] == values[b] && a < b);
+    };
+
+    auto first = order.begin() + sorted;
+    auto last = order.begin() + count;
+    size_t wanted = count - sorted;
+    size_t remaining = order.size() - sorted;
+
+    if (wanted * 16 <= remaining) {
+        // A page out of many: one pass keeps the best ones seen in a max-heap, most schedules are
+        // turned away by a single comparison with its top, then the page is moved to the front
+        vector<size_t> best;
+        best.reserve(wanted);
+        for (auto it = first; it != order.end(); ++it) {
+            if (best.size() < wanted) {
+                best.push_back(*it);
+                push_heap(best.begin(), best.end(), before);
+            } else if (before(*it, best.front())) {
+                pop_heap(best.begin(), best.end(), before);
+                best.back() = *it;
+                push_heap(best.begin(), best.end(), before);
+            }
+        }
+        size_t worst = best.front();
+        partition(first, order.end(), [&](size_t position) { return !before(worst, position); });
+    } else if (last != order.end()) {
+        nth_element(first, last - 1, order.end(), before);
+    }
+    sort(first, last, before);
+    sorted = count;
+}
+
+void ScheduleRanking::reset(vector<size_t>& order) {
+    isRanked = false;
+    sorted = 0;
+    order.resize(scores.size());
+    iota(order.begin(), order.end(), 0);
+}
+
+// One pass per metric over contiguous arrays, skipping the ones the ranking ignores.
+// A metric with the same value everywhere orders nothing and is skipped too.
+void ScheduleRanking::score(size_t first) {
+    size_t count = scores.size();
+    float* out = scores.data();
+    fill(out + first, out + count, 0.0f);
+
+    for (int metric = 0; metric < METRIC_COUNT; metric++) {
+        float range = highest[metric] - lowest[metric];
+        if (weights[metric] == 0.0f || range == 0.0f) continue;
+
+        float factor = weights[metric] / range;
+        float low = lowest[metric];
+        const float* values = metrics[metric].data();
+        for (size_t i = first; i < count; i++) {
+            out[i] += factor * (values[i] - low);
+        }
+    }
+}
+
+bool ScheduleRanking::widenRanges(size_t first) {
+    size_t count = scores.size();
+    bool widened = false;
+
+    for (int metric = 0; metric < METRIC_COUNT; metric++) {
+        const vector<float>& values = metrics[metric];
+        auto range = minmax_element(values.begin() + first, values.begin() + count);
+        float low = first == 0 ? *range.first : min(lowest[metric], *range.first);
+        float high = first == 0 ? *range.second : max(highest[metric], *range.second);
+
+        widened = widened || low != lowest[metric] || high != highest[metric];
+        lowest[metric] = low;
+        highest[metric] = high;
+    }
+    return widened;
+}
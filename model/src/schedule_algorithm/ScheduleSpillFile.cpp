@@ -0,0 +1,99 @@
+#include "ScheduleSpillFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <sys/types.h>
+#endif
+
+// Moves the write position to a byte offset, which can be past 2GB
+static bool seekTo(FILE* file, size_t offset) {
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+ScheduleSpillFile::ScheduleSpillFile(size_t recordBytes) : recordBytes(recordBytes) {
+    // Removed by the system once closed, also when the process ends without closing it
+    file = tmpfile();
+    if (!file) {
+        Logger::get().logWarning("Could not create a temporary file for schedules");
+    }
+}
+
+ScheduleSpillFile::~ScheduleSpillFile() {
+    unmap();
+    if (file) {
+        fclose(file);
+    }
+}
+
+bool ScheduleSpillFile::append(const uint8_t* records, size_t count) {
+    if (!file) return false;
+    if (count == 0) return true;
+
+    // Written right after the last counted record, so bytes left by an earlier failed append are overwritten
+    // and record(index) keeps matching the offset of the index-th record
+    if (!seekTo(file, recordCount * recordBytes)
+        || fwrite(records, recordBytes, count, file) != count || fflush(file) != 0) {
+        Logger::get().logError("Could not write schedules to the temporary file");
+        return false;
+    }
+
+    if (!remap((recordCount + count) * recordBytes)) {
+        return false;
+    }
+    recordCount += count;
+    return true;
+}
+
+bool ScheduleSpillFile::remap(size_t bytes) {
+#ifdef _WIN32
+    HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+    HANDLE view = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* address = view ? MapViewOfFile(view, FILE_MAP_READ, 0, 0, bytes) : nullptr;
+    if (!address) {
+        if (view) CloseHandle(view);
+        Logger::get().logError("Could not map the temporary schedules file");
+        return false;
+    }
+
+    unmap();
+    mapping = view;
+#else
+    void* address = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fileno(file), 0);
+    if (address == MAP_FAILED) {
+        Logger::get().logError("Could not map the temporary schedules file");
+        return false;
+    }
+
+    unmap();
+#endif
+    mapped = static_cast<const uint8_t*>(address);
+    mappedBytes = bytes;
+    return true;
+}
+
+void ScheduleSpillFile::unmap() {
+    if (!mapped) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(mapped);
+    CloseHandle(mapping);
+    mapping = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(mapped), mappedBytes);
+#endif
+    mapped = nullptr;
+    mappedBytes = 0;
+}
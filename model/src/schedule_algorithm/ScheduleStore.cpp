@@ -0,0 +1,282 @@
+#include "ScheduleStore.h"
+
+using namespace std;
+
+ScheduleStore::ScheduleStore(shared_ptr<const ScheduleCatalog> catalog)
+        : scheduleCatalog(std::move(catalog)),
+          courseCount(scheduleCatalog ? scheduleCatalog->options.size() : 0) {}
+
+ScheduleMetrics ScheduleStore::metrics(size_t position) const {
+    if (position >= spilledCount) {
+        return metricsList[position - spilledCount];
+    }
+
+    ScheduleMetrics metrics;
+    memcpy(&metrics, spillFile->record(position) + courseCount * sizeof(uint32_t), sizeof(ScheduleMetrics));
+    return metrics;
+}
+
+uint32_t ScheduleStore::option(size_t position, size_t course) const {
+    if (position >= spilledCount) {
+        return optionIndices[(position - spilledCount) * courseCount + course];
+    }
+
+    uint32_t option;
+    memcpy(&option, spillFile->record(position) + course * sizeof(uint32_t), sizeof(uint32_t));
+    return option;
+}
+
+void ScheduleStore::add(const vector<int>& chosenOptions, const ScheduleMetrics& metrics) {
+    for (size_t course = 0; course < courseCount; course++) {
+        optionIndices.push_back(static_cast<uint32_t>(chosenOptions[course]));
+    }
+    metricsList.push_back(metrics);
+    spillIfFull();
+}
+
+void ScheduleStore::addFrom(const ScheduleStore& other, size_t position) {
+    if (position >= other.spilledCount) {
+        size_t held = position - other.spilledCount;
+        optionIndices.insert(optionIndices.end(),
+                             other.optionIndices.begin() + held * courseCount,
+                             other.optionIndices.begin() + (held + 1) * courseCount);
+        metricsList.push_back(other.metricsList[held]);
+    } else {
+        for (size_t course = 0; course < courseCount; course++) {
+            optionIndices.push_back(other.option(position, course));
+        }
+        metricsList.push_back(other.metrics(position));
+    }
+    spillIfFull();
+}
+
+// Adds the schedules of another store of the same generation behind the ones held
+void ScheduleStore::append(const ScheduleStore& other) {
+    if (!scheduleCatalog) {
+        scheduleCatalog = other.scheduleCatalog;
+        courseCount = other.courseCount;
+        baseIndex = other.baseIndex;
+    }
+
+    for (size_t position = 0; position < other.spilledCount; position++) {
+        addFrom(other, position);
+    }
+
+    optionIndices.insert(optionIndices.end(), other.optionIndices.begin(), other.optionIndices.end());
+    metricsList.insert(metricsList.end(), other.metricsList.begin(), other.metricsList.end());
+    spillIfFull();
+}
+
+// Keeps the first count schedules. Records dropped from the temporary file stay in it, the next
+// spill then continues in a file of its own.
+void ScheduleStore::truncate(size_t count) {
+    if (count >= size()) return;
+
+    if (count >= spilledCount) {
+        optionIndices.resize((count - spilledCount) * courseCount);
+        metricsList.resize(count - spilledCount);
+    } else {
+        optionIndices.clear();
+        metricsList.clear();
+        spilledCount = count;
+        if (count == 0) spillFile.reset();
+    }
+}
+
+void ScheduleStore::clear() {
+    optionIndices.clear();
+    metricsList.clear();
+    spillFile.reset();
+    spilledCount = 0;
+}
+
+// Moves the schedules held in memory to the end of the temporary file once they fill the memory window
+void ScheduleStore::spillIfFull() {
+    size_t window = memoryWindow != 0 ? memoryWindow : max<size_t>(1, MEMORY_WINDOW_BYTES / recordBytes());
+    if (metricsList.size() < window || courseCount == 0) return;
+
+    try {
+        // Another copy reads the file or already wrote past this store's schedules, continue in a file of our own
+        if (!spillFile || spillFile.use_count() > 1 || spillFile->size() != spilledCount) {
+            auto ownFile = make_shared<ScheduleSpillFile>(recordBytes());
+            if (!ownFile->isOpen() || (spilledCount > 0 && !ownFile->append(spillFile->record(0), spilledCount))) {
+                throw runtime_error("no temporary file");
+            }
+            spillFile = std::move(ownFile);
+        }
+
+        size_t held = metricsList.size();
+        size_t indicesBytes = courseCount * sizeof(uint32_t);
+        vector<uint8_t> records(held * recordBytes(), 0);
+        for (size_t position = 0; position < held; position++) {
+            uint8_t* record = records.data() + position * recordBytes();
+            memcpy(record, optionIndices.data() + position * courseCount, indicesBytes);
+            memcpy(record + indicesBytes, &metricsList[position], sizeof(ScheduleMetrics));
+        }
+
+        if (!spillFile->append(records.data(), held)) {
+            throw runtime_error("write failed");
+        }
+
+        spilledCount += held;
+        optionIndices.clear();
+        metricsList.clear();
+    } catch (const exception& e) {
+        // The schedules stay readable, only the memory is no longer bounded
+        Logger::get().logWarning("Keeping every schedule in memory, moving them to a temporary file failed: " + string(e.what()));
+        memoryWindow = SIZE_MAX;
+    }
+}
+
+size_t ScheduleStore::memoryBytes() const {
+    return optionIndices.capacity() * sizeof(uint32_t) + metricsList.capacity() * sizeof(ScheduleMetrics);
+}
+
+// Product of the variant counts of the chosen options, saturating instead of overflowing
+size_t ScheduleStore::variantCount(size_t position) const {
+    if (!scheduleCatalog || scheduleCatalog->variants.empty()) return 1;
+
+    size_t count = 1;
+    for (size_t course = 0; course < courseCount; course++) {
+        size_t options = scheduleCatalog->variants[course][option(position, course)].size();
+        if (options > 1 && count > SIZE_MAX / options) return SIZE_MAX;
+        count *= max<size_t>(1, options);
+    }
+    return count;
+}
+
+// Expands the stored option indices to a full schedule. The variant is read as a mixed-radix number,
+// one digit per course choosing among the same-time alternatives of its option.
+InformativeSchedule ScheduleStore::materialize(size_t position, size_t variant) const {
+    InformativeSchedule schedule;
+    schedule.index = baseIndex + static_cast<int>(position);
+
+    const vector<string> dayNames = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
+
+    try {
+        map<int, vector<ScheduleItem>> daySchedules;
+        bool collapsed = !scheduleCatalog->variants.empty();
+
+        for (size_t course = 0; course < courseCount; course++) {
+            uint32_t chosen = option(position, course);
+            const CourseSelection* choice = &scheduleCatalog->options[course][chosen];
+
+            if (collapsed) {
+                const vector<CourseSelection>& alternatives = scheduleCatalog->variants[course][chosen];
+                if (!alternatives.empty()) {
+                    choice = &alternatives[variant % alternatives.size()];
+                    variant /= alternatives.size();
+                }
+            }
+            const CourseSelection& selection = *choice;
+
+            if (selection.lectureGroup) {
+                processGroupSessions(selection, selection.lectureGroup, "Lecture", daySchedules);
+            }
+
+            if (selection.tutorialGroup) {
+                processGroupSessions(selection, selection.tutorialGroup, "Tutorial", daySchedules);
+            }
+
+            if (selection.labGroup) {
+                processGroupSessions(selection, selection.labGroup, "Lab", daySchedules);
+            }
+
+            if (selection.blockGroup) {
+                processGroupSessions(selection, selection.blockGroup, "Block", daySchedules);
+            }
+        }
+
+        for (int day = 0; day < 7; day++) {
+            ScheduleDay scheduleDay;
+            scheduleDay.day = dayNames[day];
+
+            int algorithmDay = day + 1;
+
+            if (daySchedules.find(algorithmDay) != daySchedules.end()) {
+                auto& dayItems = daySchedules[algorithmDay];
+                sort(dayItems.begin(), dayItems.end(), [](const ScheduleItem& a, const ScheduleItem& b) {
+                    return a.start_minutes < b.start_minutes;
+                });
+                scheduleDay.day_items = dayItems;
+            }
+
+            schedule.week.push_back(scheduleDay);
+        }
+
+        ScheduleMetrics metrics = this->metrics(position);
+        schedule.amount_days = metrics.amount_days;
+        schedule.amount_gaps = metrics.amount_gaps;
+        schedule.gaps_time = metrics.gaps_time;
+        schedule.avg_start = metrics.avg_start;
+        schedule.avg_end = metrics.avg_end;
+
+    } catch (const exception& e) {
+        Logger::get().logError("Exception in ScheduleStore::materialize: " + string(e.what()));
+        schedule.week.clear();
+        for (int day = 0; day < 7; day++) {
+            ScheduleDay scheduleDay;
+            scheduleDay.day = dayNames[day];
+            schedule.week.push_back(scheduleDay);
+        }
+    }
+
+    return schedule;
+}
+
+vector<InformativeSchedule> ScheduleStore::materializeAll() const {
+    vector<InformativeSchedule> schedules;
+    schedules.reserve(size());
+    for (size_t position = 0; position < size(); position++) {
+        schedules.push_back(materialize(position));
+    }
+    return schedules;
+}
+
+// Helper method to process all sessions in a group and add them to the day schedules
+void ScheduleStore::processGroupSessions(const CourseSelection& selection,
+                                         const Group* group,
+                                         const string& sessionType,
+                                         map<int, vector<ScheduleItem>>& daySchedules) const {
+    if (!group) return;
+
+    try {
+        string courseName = getCourseNameById(selection.courseId);
+        string courseRawId = getCourseRawIdById(selection.courseId);
+
+        for (const auto& session : group->sessions) {
+
+            ScheduleItem item;
+            item.courseName = courseName;
+            item.raw_id = courseRawId;
+            item.type = sessionType;
+            item.start_minutes = session.start_minutes;
+            item.end_minutes = session.end_minutes;
+            item.building = session.building_number;
+            item.room = session.room_number;
+
+            daySchedules[session.day_of_week].push_back(item);
+        }
+
+    } catch (const exception& e) {
+        Logger::get().logError("Exception in processGroupSessions: " + string(e.what()));
+    }
+}
+
+string ScheduleStore::getCourseNameById(int courseId) const {
+    auto it = scheduleCatalog->courseInfo.find(courseId);
+    if (it != scheduleCatalog->courseInfo.end()) {
+        return it->second.name;
+    }
+    Logger::get().logWarning("Course ID " + to_string(courseId) + " not found in course info map");
+    return "Unknown Course";
+}
+
+string ScheduleStore::getCourseRawIdById(int courseId) const {
+    auto it = scheduleCatalog->courseInfo.find(courseId);
+    if (it != scheduleCatalog->courseInfo.end()) {
+        return it->second.raw_id;
+    }
+    Logger::get().logWarning("Course ID " + to_string(courseId) + " not found in course info map");
+    return "UNKNOWN";
+}
@@ -0,0 +1,95 @@
+#include "SessionIntervals.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SESSION_INTERVALS_AVX2
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SESSION_INTERVALS_SSE2
+#endif
+
+using namespace std;
+
+bool SessionIntervals::add(const Session& session) {
+    if (session.start_minutes < 0 || session.end_minutes < 0) return false;
+
+    add(session.day_of_week, session.start_minutes, session.end_minutes);
+    return true;
+}
+
+void SessionIntervals::add(int day, int startMinutes, int endMinutes) {
+    days.push_back(static_cast<int16_t>(day));
+    starts.push_back(static_cast<int16_t>(startMinutes));
+    ends.push_back(static_cast<int16_t>(endMinutes));
+}
+
+void SessionIntervals::clear() {
+    days.clear();
+    starts.clear();
+    ends.clear();
+}
+
+// An interval overlaps [startMinutes, endMinutes) when it is on the same day, starts before the end and ends after the start
+bool SessionIntervals::overlaps(int day, int startMinutes, int endMinutes) const {
+    const size_t count = days.size();
+    size_t i = 0;
+
+#ifdef SESSION_INTERVALS_AVX2
+    const __m256i day16 = _mm256_set1_epi16(static_cast<int16_t>(day));
+    const __m256i start16 = _mm256_set1_epi16(static_cast<int16_t>(startMinutes));
+    const __m256i end16 = _mm256_set1_epi16(static_cast<int16_t>(endMinutes));
+
+    for (; i + 16 <= count; i += 16) {
+        __m256i blockDays = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&days[i]));
+        __m256i blockStarts = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&starts[i]));
+        __m256i blockEnds = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&ends[i]));
+
+        __m256i hit = _mm256_and_si256(_mm256_cmpeq_epi16(blockDays, day16),
+                                       _mm256_and_si256(_mm256_cmpgt_epi16(end16, blockStarts),
+                                                        _mm256_cmpgt_epi16(blockEnds, start16)));
+        if (!_mm256_testz_si256(hit, hit)) return true;
+    }
+#endif
+
+#ifdef SESSION_INTERVALS_SSE2
+    const __m128i day8 = _mm_set1_epi16(static_cast<int16_t>(day));
+    const __m128i start8 = _mm_set1_epi16(static_cast<int16_t>(startMinutes));
+    const __m128i end8 = _mm_set1_epi16(static_cast<int16_t>(endMinutes));
+
+    for (; i + 8 <= count; i += 8) {
+        __m128i blockDays = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&days[i]));
+        __m128i blockStarts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&starts[i]));
+        __m128i blockEnds = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&ends[i]));
+
+        __m128i hit = _mm_and_si128(_mm_cmpeq_epi16(blockDays, day8),
+                                    _mm_and_si128(_mm_cmplt_epi16(blockStarts, end8),
+                                                  _mm_cmpgt_epi16(blockEnds, start8)));
+        if (_mm_movemask_epi8(hit) != 0) return true;
+    }
+#endif
+
+    for (; i < count; i++) {
+        if (days[i] == day && starts[i] < endMinutes && startMinutes < ends[i]) return true;
+    }
+    return false;
+}
+
+bool SessionIntervals::overlaps(const SessionIntervals& other) const {
+    // Walk the shorter list, so the kernel gets the longer one
+    const SessionIntervals& walked = size() <= other.size() ? *this : other;
+    const SessionIntervals& blocked = size() <= other.size() ? other : *this;
+
+    for (size_t i = 0; i < walked.size(); i++) {
+        if (blocked.overlaps(walked.days[i], walked.starts[i], walked.ends[i])) return true;
+    }
+    return false;
+}
+
+bool SessionIntervals::overlapsScalar(int day, int startMinutes, int endMinutes) const {
+    for (size_t i = 0; i < days.size(); i++) {
+        if (days[i] == day && starts[i] < endMinutes && startMinutes < ends[i]) return true;
+    }
+    return false;
+}
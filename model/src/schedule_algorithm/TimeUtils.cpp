@@ -1,41 +1,62 @@
 #include "TimeUtils.h"
 
+#include <cctype>
+#include <cstdio>
+
 using namespace std;
 
 // Converts a time string in the format "HH:MM" to total minutes since midnight
 int TimeUtils::toMinutes(const std::string& t) {
-    try {
-        size_t colonPos = t.find(':'); // Find the position of the colon separator
-        if (colonPos == std::string::npos) {
-            // Throw error if colon is missing
-            throw std::invalid_argument("Missing colon in time string: " + t);
-        }
-
-        // Extract hour and minute substrings
-        std::string hourStr = t.substr(0, colonPos);
-        std::string minuteStr = t.substr(colonPos + 1);
-
-        // Check for empty parts (e.g., ":30" or "13:")
-        if (hourStr.empty() || minuteStr.empty()) {
-            throw std::invalid_argument("Empty hour or minute in time string: " + t);
-        }
-
-        // Convert to integers
-        int hours = std::stoi(hourStr);
-        int minutes = std::stoi(minuteStr);
-
-        // Validate range for hours and minutes
-        if (hours < 0 || hours > 23 || minutes < 0 || minutes > 59) {
-            throw std::invalid_argument("Hour or minute out of range: " + t);
-        }
-
-        // Convert to total minutes
-        return hours * 60 + minutes;
-    } catch (const std::exception& e) {
-        // Log any parsing or conversion errors
-        Logger::get().logError("toMinutes() error: " + string(e.what()));
-        throw; // Rethrow to propagate the exception
+    int minutes;
+    if (parseMinutes(t, minutes)) return minutes;
+
+    // Log the parsing error and throw to propagate it
+    Logger::get().logError("toMinutes() error: invalid time string: " + t);
+    throw std::invalid_argument("Invalid time string: " + t);
+}
+
+// Reads a number the way stoi does: leading whitespace, an optional sign, then digits up to the first other character
+static bool parseNumber(const std::string& t, size_t begin, size_t end, int& value) {
+    size_t i = begin;
+    while (i < end && isspace(static_cast<unsigned char>(t[i]))) i++;
+
+    bool negative = false;
+    if (i < end && (t[i] == '+' || t[i] == '-')) {
+        negative = t[i] == '-';
+        i++;
     }
+
+    if (i == end || t[i] < '0' || t[i] > '9') return false;
+
+    value = 0;
+    for (; i < end && t[i] >= '0' && t[i] <= '9'; i++) {
+        value = value * 10 + (t[i] - '0');
+        if (value > 9999) return false;  // out of range either way, and keeps the value from overflowing
+    }
+    if (negative) value = -value;
+    return true;
+}
+
+bool TimeUtils::parseMinutes(const std::string& t, int& minutes) {
+    size_t colonPos = t.find(':'); // Find the position of the colon separator
+    if (colonPos == std::string::npos) return false;
+
+    int hours, mins;
+    if (!parseNumber(t, 0, colonPos, hours) || !parseNumber(t, colonPos + 1, t.size(), mins)) return false;
+
+    // Validate range for hours and minutes
+    if (hours < 0 || hours > 23 || mins < 0 || mins > 59) return false;
+
+    minutes = hours * 60 + mins;
+    return true;
+}
+
+std::string TimeUtils::formatMinutes(int minutes) {
+    if (minutes < 0) return "";
+
+    char text[8];
+    snprintf(text, sizeof(text), "%02d:%02d", (minutes / 60) % 100, minutes % 60);
+    return text;
 }
 
 // Determines whether two sessions overlap in time on the same day
@@ -46,21 +67,9 @@ bool TimeUtils::isOverlap(const Session* s1, const Session* s2) {
         return false;
     }
 
-    try {
-        // Sessions on different days cannot overlap
-        if (s1->day_of_week != s2->day_of_week) return false;
-
-        // Convert start and end times to minutes
-        int start1 = toMinutes(s1->start_time);
-        int end1 = toMinutes(s1->end_time);
-        int start2 = toMinutes(s2->start_time);
-        int end2 = toMinutes(s2->end_time);
-
-        // Return true if the time intervals overlap
-        return (start1 < end2 && start2 < end1);
-    } catch (const std::exception& e) {
-        // Log any exception that occurs during overlap calculation
-        Logger::get().logError("isOverlap() error comparing sessions: " + string(e.what()));
-        return false;
-    }
+    // Sessions on different days cannot overlap
+    if (s1->day_of_week != s2->day_of_week) return false;
+
+    // Return true if the time intervals overlap
+    return (s1->start_minutes < s2->end_minutes && s2->start_minutes < s1->end_minutes);
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "WorkStealingPool.h"
+
+using namespace std;
+
+WorkStealingPool::WorkStealingPool(int threadCount) : threadCount(max(1, threadCount)) {
+    for (int i = 0; i < this->threadCount; i++) {
+        queues.push_back(make_unique<WorkerQueue>());
+    }
+}
+
+int WorkStealingPool::defaultThreadCount() {
+    unsigned int hardwareThreads = thread::hardware_concurrency();
+    return hardwareThreads == 0 ? 1 : static_cast<int>(hardwareThreads);
+}
+
+void WorkStealingPool::run(size_t taskCount, const function<void(size_t)>& task) {
+    if (taskCount == 0) return;
+
+    // Hand out contiguous blocks, so each worker starts on neighbouring subtrees
+    for (int worker = 0; worker < threadCount; worker++) {
+        size_t first = taskCount * worker / threadCount;
+        size_t last = taskCount * (worker + 1) / threadCount;
+
+        lock_guard<mutex> guard(queues[worker]->lock);
+        queues[worker]->tasks.clear();
+        for (size_t i = last; i > first; i--) {
+            queues[worker]->tasks.push_back(i - 1);
+        }
+    }
+
+    // The calling thread works as worker 0
+    vector<thread> threads;
+    for (int worker = 1; worker < threadCount; worker++) {
+        threads.emplace_back(&WorkStealingPool::work, this, worker, cref(task));
+    }
+    work(0, task);
+
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+void WorkStealingPool::work(int worker, const function<void(size_t)>& task) {
+    size_t taskIndex;
+
+    while (popLocal(worker, taskIndex) || steal(worker, taskIndex)) {
+        try {
+            task(taskIndex);
+        } catch (const exception& e) {
+            Logger::get().logError("Exception in WorkStealingPool task: " + string(e.what()));
+        }
+    }
+}
+
+bool WorkStealingPool::popLocal(int worker, size_t& taskIndex) {
+    lock_guard<mutex> guard(queues[worker]->lock);
+    if (queues[worker]->tasks.empty()) return false;
+
+    taskIndex = queues[worker]->tasks.back();
+    queues[worker]->tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(int thief, size_t& taskIndex) {
+    for (int offset = 1; offset < threadCount; offset++) {
+        int victim = (thief + offset) % threadCount;
+
+        lock_guard<mutex> guard(queues[victim]->lock);
+        if (queues[victim]->tasks.empty()) continue;
+
+        taskIndex = queues[victim]->tasks.front();
+        queues[victim]->tasks.pop_front();
+        return true;
+    }
+    return false;
+}
@@ -1,6 +1,11 @@
 #ifndef MODEL_INTERFACES_H
 #define MODEL_INTERFACES_H
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -17,8 +22,8 @@ enum class SessionType {
 class Session {
 public:
     int day_of_week;
-    string start_time;
-    string end_time;
+    int start_minutes = -1;  // minutes since midnight, parsed once when the session is read; -1 when missing
+    int end_minutes = -1;
     string building_number;
     string room_number;
 };
@@ -45,8 +50,8 @@ struct ScheduleItem {
     string courseName;
     string raw_id;
     string type;
-    string start;
-    string end;
+    int start_minutes = -1;  // minutes since midnight, formatted only for display and export
+    int end_minutes = -1;
     string building;
     string room;
 };
@@ -66,14 +71,109 @@ struct InformativeSchedule {
     vector<ScheduleDay> week;
 };
 
+class ScheduleStore;
+
+enum class ScheduleMetric {
+    AMOUNT_DAYS,
+    AMOUNT_GAPS,
+    GAPS_TIME,
+    AVG_START,
+    AVG_END
+};
+
+// What makes one schedule better than another, used to rank schedules while generating
+struct ScheduleObjective {
+    ScheduleMetric metric = ScheduleMetric::AMOUNT_GAPS;
+    bool ascending = true;  // lower values are better
+};
+
+// Takes ownership of a batch of schedules while generation is still running, returning false stops the search
+using ScheduleBatchCallback = function<bool(ScheduleStore&& batch)>;
+
+// Limits of one generation, 0 leaves a limit off. Generation stops at the first one reached
+// and keeps the schedules found so far, marked as truncated.
+struct GenerationBudget {
+    size_t maxResults = 0;
+    size_t maxMemoryBytes = 0;              // memory of the stored schedules
+    std::chrono::milliseconds maxTime{0};   // wall time of the search
+};
+
+// A break between consecutive sessions of a day counts as a gap from this length on, in the
+// schedule metrics and in the gap limits alike
+constexpr int MIN_GAP_MINUTES = 30;
+
+// Limits every generated schedule has to meet, -1 leaves a limit off. Times are minutes from midnight.
+// They are checked during the search, so branches that cannot meet them are cut instead of filtered out later.
+struct ScheduleConstraints {
+    int maxDays = -1;        // days with sessions
+    int maxGaps = -1;        // gaps between consecutive sessions of a day
+    int maxGapMinutes = -1;  // longest gap between consecutive sessions of a day
+    int earliestStart = -1;  // no session starts before it
+    int minAvgStart = -1;    // average start of the days with sessions
+    int maxAvgEnd = -1;      // average end of the days with sessions
+
+    bool any() const {
+        return maxDays >= 0 || maxGaps >= 0 || maxGapMinutes >= 0 ||
+               earliestStart >= 0 || minAvgStart >= 0 || maxAvgEnd >= 0;
+    }
+
+    // Limits that depend on the options chosen together; the earliest start only drops options
+    bool limitsMetrics() const {
+        return maxDays >= 0 || maxGaps >= 0 || maxGapMinutes >= 0 || minAvgStart >= 0 || maxAvgEnd >= 0;
+    }
+
+    bool operator==(const ScheduleConstraints& other) const {
+        return maxDays == other.maxDays && maxGaps == other.maxGaps && maxGapMinutes == other.maxGapMinutes &&
+               earliestStart == other.earliestStart && minAvgStart == other.minAvgStart && maxAvgEnd == other.maxAvgEnd;
+    }
+};
+
+// Shared by a generation and whoever may stop it. The search notices a cancel within a few thousand
+// nodes and returns what it found so far.
+class CancellationToken {
+public:
+    void cancel() { cancelled.store(true, memory_order_relaxed); }
+    bool isCancelled() const { return cancelled.load(memory_order_relaxed); }
+
+private:
+    atomic<bool> cancelled{false};
+};
+
+// Receives the explored fraction of the search tree, from 0 to 1. Called from the search threads,
+// at most a few times per second.
+using ScheduleProgressCallback = function<void(double explored)>;
+
+struct ScheduleGenerationRequest {
+    vector<Course> courses;
+    vector<Session> blockedTimes;   // Times the user keeps free, no schedule overlaps them
+    bool collapseSameTimes = false; // One schedule per distinct week, others in other groups or rooms become its variants
+    ScheduleConstraints constraints;  // GENERATE_SCHEDULES, GENERATE_TOP_K, GENERATE_PARETO and COUNT_SCHEDULES, samples only take the earliest start
+    GenerationBudget budget;
+    ScheduleBatchCallback onBatch;  // Optional, schedules streamed to it are not returned again at the end
+    ScheduleProgressCallback onProgress;          // Optional
+    shared_ptr<CancellationToken> cancellation;  // Optional, stops the generation once cancelled
+    shared_ptr<const ScheduleStore> previous;    // GENERATE_SCHEDULES only, optional; a complete earlier run, extended when a course was added
+    size_t batchSize = 0;           // Schedules per batch, 0 keeps the builder's default
+    ScheduleObjective objective;    // GENERATE_TOP_K only
+    size_t topK = 0;                // GENERATE_TOP_K only, number of best schedules to keep
+    vector<ScheduleObjective> paretoObjectives;  // GENERATE_PARETO only, the objectives schedules trade off
+    size_t sampleSize = 0;          // SAMPLE_SCHEDULES only, number of schedules to draw
+    uint64_t sampleSeed = 0;        // SAMPLE_SCHEDULES only, the same seed draws the same schedules
+};
+
 enum class ModelOperation {
     GENERATE_COURSES,
     VALIDATE_COURSES,
     GENERATE_SCHEDULES,
+    GENERATE_TOP_K,
+    GENERATE_PARETO,
+    COUNT_SCHEDULES,
+    SAMPLE_SCHEDULES,
     SAVE_SCHEDULE,
     PRINT_SCHEDULE
 };
 
+// Operations returning schedules, a count or validation errors hand a new object to the caller, which deletes it
 class IModel {
 public:
     virtual ~IModel() = default;
@@ -0,0 +1,71 @@
+#include "BoundedChannel.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace std;
+
+// --- TEST CASES ---
+
+TEST(BoundedChannelTest, KeepsPushOrder) {
+    BoundedChannel<int> channel(4);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(channel.push(i));
+    }
+
+    int value;
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(channel.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(channel.tryPop(value));
+}
+
+// A full channel holds the producer back until the consumer takes an item
+TEST(BoundedChannelTest, PushWaitsWhileFull) {
+    BoundedChannel<int> channel(1);
+    ASSERT_TRUE(channel.push(1));
+
+    atomic<bool> pushed{false};
+    thread producer([&]() {
+        channel.push(2);
+        pushed = true;
+    });
+
+    this_thread::sleep_for(chrono::milliseconds(50));
+    EXPECT_FALSE(pushed.load());
+
+    int value;
+    ASSERT_TRUE(channel.pop(value));
+    EXPECT_EQ(value, 1);
+
+    producer.join();
+    EXPECT_TRUE(pushed.load());
+    ASSERT_TRUE(channel.pop(value));
+    EXPECT_EQ(value, 2);
+}
+
+// Closing releases a waiting producer, items already queued can still be taken
+TEST(BoundedChannelTest, CloseReleasesProducer) {
+    BoundedChannel<int> channel(1);
+    ASSERT_TRUE(channel.push(1));
+
+    atomic<int> result{-1};
+    thread producer([&]() {
+        result = channel.push(2) ? 1 : 0;
+    });
+
+    this_thread::sleep_for(chrono::milliseconds(20));
+    channel.close();
+    producer.join();
+
+    EXPECT_EQ(result.load(), 0);
+    EXPECT_FALSE(channel.push(3));
+
+    int value;
+    ASSERT_TRUE(channel.pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_FALSE(channel.pop(value));
+}
@@ -13,8 +13,8 @@ protected:
     Session makeSession(const string& start, const string& end, int day) {
         Session session;
         session.day_of_week = day;
-        session.start_time = start;
-        session.end_time = end;
+        session.start_minutes = TimeUtils::toMinutes(start);
+        session.end_minutes = TimeUtils::toMinutes(end);
         session.building_number = "";
         session.room_number = "";
         return session;
@@ -186,8 +186,8 @@ TEST_F(CourseLegalCombTest, SomeCombinationsValidAmongMany) {
 
     auto combinations = comb.generate(c);
     ASSERT_EQ(combinations.size(), 1); // Only one fully non-overlapping combo
-    EXPECT_EQ(combinations[0].tutorialGroup->sessions[0].start_time, "09:30");
-    EXPECT_EQ(combinations[0].labGroup->sessions[0].start_time, "10:30");
+    EXPECT_EQ(combinations[0].tutorialGroup->sessions[0].start_minutes, 570);
+    EXPECT_EQ(combinations[0].labGroup->sessions[0].start_minutes, 630);
 }
 
 // Test conflicting sessions within the same group (should be handled properly)
@@ -632,4 +632,55 @@ TEST_F(CourseLegalCombTest, BlocksWithMinimalOverlap) {
     if (combinations.size() == 1) {
         EXPECT_NE(combinations[0].blockGroup, nullptr);
     }
-}
\ No newline at end of file
+}
+
+// Occupancy mask is precomputed for every generated combination
+TEST_F(CourseLegalCombTest, CombinationsCarryOccupancyMask) {
+    vector<Session> lectureSessions = { makeSession("09:00", "10:00", Mon) };
+    Group lectureGroup = makeGroup(SessionType::LECTURE, lectureSessions);
+
+    vector<Session> tutorialSessions = { makeSession("12:00", "13:00", Tue) };
+    Group tutorialGroup = makeGroup(SessionType::TUTORIAL, tutorialSessions);
+
+    Course c = makeCourse(15, {lectureGroup}, {tutorialGroup});
+    auto combinations = comb.generate(c);
+    ASSERT_EQ(combinations.size(), 1);
+    EXPECT_TRUE(combinations[0].occupancyExact);
+
+    WeekMask tuesdayNoon;
+    ASSERT_TRUE(tuesdayNoon.addSession(makeSession("12:30", "12:45", Tue)));
+    EXPECT_TRUE(combinations[0].occupancy.intersects(tuesdayNoon));
+
+    WeekMask mondayNoon;
+    ASSERT_TRUE(mondayNoon.addSession(makeSession("12:30", "12:45", Mon)));
+    EXPECT_FALSE(combinations[0].occupancy.intersects(mondayNoon));
+}
+
+// Groups with the same times are combined once, the others are listed as equivalents
+TEST_F(CourseLegalCombTest, DistinctCombinationsListEquivalentGroups) {
+    Group lectureGroup1 = makeGroup(SessionType::LECTURE, { makeSession("08:00", "10:00", Mon) });
+    Group lectureGroup2 = makeGroup(SessionType::LECTURE, { makeSession("08:00", "10:00", Mon) });
+    Group lectureGroup3 = makeGroup(SessionType::LECTURE, { makeSession("12:00", "14:00", Mon) });
+
+    Group tutorialGroup1 = makeGroup(SessionType::TUTORIAL, { makeSession("10:00", "11:00", Tue) });
+    Group tutorialGroup2 = makeGroup(SessionType::TUTORIAL, { makeSession("10:00", "11:00", Tue) });
+
+    Course c = makeCourse(15, {lectureGroup1, lectureGroup2, lectureGroup3}, {tutorialGroup1, tutorialGroup2});
+    ASSERT_EQ(comb.generate(c).size(), 6);
+
+    vector<EquivalentGroups> equivalents;
+    auto combinations = comb.generateDistinct(c, equivalents);
+    ASSERT_EQ(combinations.size(), 2);
+    ASSERT_EQ(equivalents.size(), 2);
+
+    EXPECT_EQ(combinations[0].lectureGroup, &c.Lectures[0]);
+    EXPECT_EQ(combinations[0].tutorialGroup, &c.Tirgulim[0]);
+    ASSERT_EQ(equivalents[0].lectures.size(), 2);
+    EXPECT_EQ(equivalents[0].lectures[0], &c.Lectures[0]);
+    EXPECT_EQ(equivalents[0].lectures[1], &c.Lectures[1]);
+    EXPECT_EQ(equivalents[0].tutorials.size(), 2);
+    EXPECT_EQ(equivalents[0].labs, vector<const Group*>{nullptr});
+
+    EXPECT_EQ(combinations[1].lectureGroup, &c.Lectures[2]);
+    EXPECT_EQ(equivalents[1].lectures.size(), 1);
+}
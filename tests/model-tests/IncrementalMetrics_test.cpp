@@ -0,0 +1,83 @@
+#include "IncrementalMetrics.h"
+#include "gtest/gtest.h"
+#include "test_helpers.h"
+
+using namespace std;
+
+// One course per entry, with a single option made of one lecture group holding the sessions
+static vector<Course> makeCourses(const vector<vector<Session>>& sessionsPerCourse) {
+    vector<Course> courses;
+    for (size_t c = 0; c < sessionsPerCourse.size(); ++c) {
+        Course course;
+        course.id = static_cast<int>(40000 + c);
+        Group group;
+        group.type = SessionType::LECTURE;
+        group.sessions = sessionsPerCourse[c];
+        course.Lectures.push_back(group);
+        courses.push_back(course);
+    }
+    return courses;
+}
+
+static vector<vector<CourseSelection>> singleOptions(const vector<Course>& courses) {
+    vector<vector<CourseSelection>> allOptions;
+    for (const auto& course : courses) {
+        allOptions.push_back({{course.id, &course.Lectures[0], nullptr, nullptr, nullptr}});
+    }
+    return allOptions;
+}
+
+// --- TEST CASES ---
+
+// Metrics follow the options as they are added and removed, in any order
+TEST(IncrementalMetricsTest, FollowsAddedAndRemovedOptions) {
+    vector<Course> courses = makeCourses({
+        {makeSession(1, "08:00", "10:00"), makeSession(2, "09:00", "10:00")},
+        {makeSession(1, "12:00", "13:00")},
+        {makeSession(1, "10:15", "11:00"), makeSession(3, "14:00", "16:00")},
+    });
+    auto allOptions = singleOptions(courses);
+    OptionMinutes minutes(allOptions);
+
+    IncrementalMetrics metrics(&minutes);
+    metrics.add(2, 0);
+    metrics.add(0, 0);
+    metrics.add(1, 0);
+
+    ScheduleMetrics all = metrics.metrics();
+    EXPECT_EQ(all.amount_days, 3);
+    EXPECT_EQ(all.amount_gaps, 1);               // 11:00 - 12:00, 10:00 - 10:15 is too short
+    EXPECT_EQ(all.gaps_time, 60);
+    EXPECT_EQ(all.avg_start, (480 + 540 + 840) / 3);
+    EXPECT_EQ(all.avg_end, (780 + 600 + 960) / 3);
+
+    metrics.remove(1, 0);
+    EXPECT_EQ(metrics.gaps(), 0);
+    EXPECT_EQ(metrics.activeDays(), 3);
+    metrics.remove(2, 0);
+    EXPECT_EQ(metrics.activeDays(), 2);
+
+    metrics.add(1, 0);
+    metrics.add(2, 0);
+    EXPECT_EQ(metrics.metrics().gaps_time, all.gaps_time);
+    EXPECT_EQ(metrics.metrics().avg_end, all.avg_end);
+}
+
+// An option with a time that cannot be read gives empty metrics while it is chosen
+TEST(IncrementalMetricsTest, UnreadableTimesGiveEmptyMetrics) {
+    vector<Course> courses = makeCourses({
+        {makeSession(1, "08:00", "10:00")},
+        {makeSession(2, "0900", "10:00")},
+    });
+    auto allOptions = singleOptions(courses);
+    OptionMinutes minutes(allOptions);
+    EXPECT_FALSE(minutes.valid(1, 0));
+
+    IncrementalMetrics metrics(&minutes);
+    metrics.add(0, 0);
+    metrics.add(1, 0);
+    EXPECT_EQ(metrics.metrics().amount_days, 0);
+
+    metrics.remove(1, 0);
+    EXPECT_EQ(metrics.metrics().amount_days, 1);
+}
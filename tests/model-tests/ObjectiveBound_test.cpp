@@ -0,0 +1,61 @@
+#include "ObjectiveBound.h"
+#include "CourseLegalComb.h"
+#include "gtest/gtest.h"
+#include "test_helpers.h"
+
+using namespace std;
+
+// Builds a course with one single-session lecture group per given session
+static Course makeOptionsCourse(int id, const vector<Session>& sessions) {
+    Course course;
+    course.id = id;
+    course.raw_id = to_string(id);
+    for (const auto& session : sessions) {
+        Group group;
+        group.type = SessionType::LECTURE;
+        group.sessions.push_back(session);
+        course.Lectures.push_back(group);
+    }
+    return course;
+}
+
+// --- TEST CASES ---
+
+// Fewest days can not drop below the days already used, most days counts every day still reachable
+TEST(ObjectiveBoundTest, BoundsDaysByUsedAndReachableDays) {
+    Course first = makeOptionsCourse(20001, {makeSession(1, "08:00", "10:00")});
+    Course second = makeOptionsCourse(20002, {makeSession(1, "12:00", "13:00"), makeSession(3, "12:00", "13:00")});
+    vector<vector<CourseSelection>> allOptions = {CourseLegalComb::generate(first), CourseLegalComb::generate(second)};
+
+    ObjectiveBound fewest(allOptions, {ScheduleMetric::AMOUNT_DAYS, true});
+    ObjectiveBound most(allOptions, {ScheduleMetric::AMOUNT_DAYS, false});
+
+    EXPECT_EQ(fewest.lowerBound({0, -1}), 1);
+    EXPECT_EQ(most.lowerBound({0, -1}), -2);
+
+    ScheduleMetrics metrics;
+    metrics.amount_days = 2;
+    EXPECT_EQ(fewest.score(metrics), 2);
+    EXPECT_EQ(most.score(metrics), -2);
+}
+
+// A gap counts towards the bound only when no remaining course can fill it
+TEST(ObjectiveBoundTest, CountsOnlyGapsNoCourseCanFill) {
+    Course first = makeOptionsCourse(20011, {makeSession(1, "08:00", "09:00")});
+    Course second = makeOptionsCourse(20012, {makeSession(1, "12:00", "13:00")});
+    Course filler = makeOptionsCourse(20013, {makeSession(1, "10:00", "11:00")});
+    Course elsewhere = makeOptionsCourse(20014, {makeSession(2, "10:00", "11:00")});
+
+    vector<vector<CourseSelection>> withFiller = {CourseLegalComb::generate(first), CourseLegalComb::generate(second),
+                                                  CourseLegalComb::generate(filler)};
+    ObjectiveBound filled(withFiller, {ScheduleMetric::GAPS_TIME, true});
+    EXPECT_EQ(filled.lowerBound({0, 0, -1}), 0);
+
+    vector<vector<CourseSelection>> withoutFiller = {CourseLegalComb::generate(first), CourseLegalComb::generate(second),
+                                                     CourseLegalComb::generate(elsewhere)};
+    ObjectiveBound kept(withoutFiller, {ScheduleMetric::GAPS_TIME, true});
+    EXPECT_EQ(kept.lowerBound({0, 0, -1}), 180);
+
+    ObjectiveBound most(withoutFiller, {ScheduleMetric::GAPS_TIME, false});
+    EXPECT_FALSE(most.canPrune());
+}
@@ -0,0 +1,103 @@
+#include "OptionCompatibility.h"
+#include "CourseLegalComb.h"
+#include "gtest/gtest.h"
+#include "test_helpers.h"
+
+using namespace std;
+
+// Conflict check used to build the tables under test
+static bool masksConflict(const CourseSelection& a, const CourseSelection& b) {
+    return a.occupancy.intersects(b.occupancy);
+}
+
+// Builds a course with one single-session lecture group per given start hour on the same day
+static Course makeHourlyCourse(int id, const vector<int>& startHours) {
+    Course course;
+    course.id = id;
+    course.raw_id = to_string(id);
+    for (int hour : startHours) {
+        Group group;
+        group.type = SessionType::LECTURE;
+        group.sessions.push_back(makeSession(1, to_string(hour) + ":00", to_string(hour + 1) + ":00"));
+        course.Lectures.push_back(group);
+    }
+    return course;
+}
+
+static bool hasBit(const uint64_t* bits, int index) {
+    return (bits[index / 64] >> (index % 64)) & 1ULL;
+}
+
+// --- TEST CASES ---
+
+// Options at the same hour are incompatible, options at different hours are compatible
+TEST(OptionCompatibilityTest, MarksCompatiblePairsBothWays) {
+    Course a = makeHourlyCourse(10001, {8, 9});
+    Course b = makeHourlyCourse(10002, {9, 10, 11});
+    vector<vector<CourseSelection>> allOptions = {CourseLegalComb::generate(a), CourseLegalComb::generate(b)};
+
+    OptionCompatibility compatibility(allOptions, &masksConflict);
+
+    const uint64_t* fromA1 = compatibility.compatibleOptions(0, 1, 1);  // 09:00 option of A
+    EXPECT_FALSE(hasBit(fromA1, 0));
+    EXPECT_TRUE(hasBit(fromA1, 1));
+    EXPECT_TRUE(hasBit(fromA1, 2));
+
+    const uint64_t* fromB0 = compatibility.compatibleOptions(1, 0, 0);  // 09:00 option of B
+    EXPECT_TRUE(hasBit(fromB0, 0));
+    EXPECT_FALSE(hasBit(fromB0, 1));
+}
+
+// Bitsets spanning more than one word keep every option addressable
+TEST(OptionCompatibilityTest, HandlesMoreThanSixtyFourOptions) {
+    Course many;
+    many.id = 10003;
+    many.raw_id = "10003";
+    for (int i = 0; i < 70; i++) {
+        Group group;
+        group.type = SessionType::LECTURE;
+        group.sessions.push_back(makeSession(2 + (i % 5), i < 35 ? "08:00" : "12:00", i < 35 ? "09:00" : "13:00"));
+        many.Lectures.push_back(group);
+    }
+    Course single = makeHourlyCourse(10004, {12});
+    vector<vector<CourseSelection>> allOptions = {CourseLegalComb::generate(many), CourseLegalComb::generate(single)};
+
+    OptionCompatibility compatibility(allOptions, &masksConflict);
+    ASSERT_EQ(compatibility.wordCount(0), 2);
+
+    vector<uint64_t> all;
+    compatibility.fillAll(0, all);
+    EXPECT_TRUE(hasBit(all.data(), 69));
+    EXPECT_FALSE(hasBit(all.data(), 70));
+
+    // The single option sits on day 1, which none of the 70 options use
+    const uint64_t* fromSingle = compatibility.compatibleOptions(1, 0, 0);
+    for (int i = 0; i < 70; i++) {
+        EXPECT_TRUE(hasBit(fromSingle, i));
+    }
+}
+
+// Narrowing keeps only compatible options of later courses and reports a course left without any
+TEST(OptionCompatibilityTest, NarrowingDetectsEmptiedDomain) {
+    Course a = makeHourlyCourse(10005, {8, 9});
+    Course b = makeHourlyCourse(10006, {9, 10});
+    Course c = makeHourlyCourse(10007, {8});
+    vector<vector<CourseSelection>> allOptions = {CourseLegalComb::generate(a), CourseLegalComb::generate(b),
+                                                  CourseLegalComb::generate(c)};
+
+    OptionCompatibility compatibility(allOptions, &masksConflict);
+    vector<uint64_t> domains;
+    compatibility.fillDomains(domains);
+    vector<uint64_t> narrowed(compatibility.domainWords(), 0);
+
+    // 09:00 of A rules out 09:00 of B and leaves C its only option
+    ASSERT_TRUE(compatibility.narrowDomains(0, 1, {1, 2}, domains.data(), narrowed.data()));
+    EXPECT_FALSE(hasBit(&narrowed[compatibility.domainOffset(1)], 0));
+    EXPECT_TRUE(hasBit(&narrowed[compatibility.domainOffset(1)], 1));
+    EXPECT_TRUE(hasBit(&narrowed[compatibility.domainOffset(2)], 0));
+    EXPECT_EQ(compatibility.remainingOptions(1, narrowed.data()), 1);
+    EXPECT_EQ(compatibility.remainingOptions(1, domains.data()), 2);
+
+    // 08:00 of A takes the only hour C has
+    EXPECT_FALSE(compatibility.narrowDomains(0, 0, {1, 2}, domains.data(), narrowed.data()));
+}
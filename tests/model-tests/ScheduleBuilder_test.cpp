@@ -3,6 +3,9 @@
 #include "parseCoursesToVector.h"
 #include "model_interfaces.h"
 
+#include <atomic>
+#include <thread>
+
 using namespace std;
 
 // Helper to create a session with given parameters
@@ -10,8 +13,8 @@ Session makeTestSession(int day_of_week, const string& start_time, const string&
                        const string& building = "", const string& room = "") {
     Session session;
     session.day_of_week = day_of_week;
-    session.start_time = start_time;
-    session.end_time = end_time;
+    session.start_minutes = TimeUtils::toMinutes(start_time);
+    session.end_minutes = TimeUtils::toMinutes(end_time);
     session.building_number = building;
     session.room_number = room;
     return session;
@@ -304,4 +307,888 @@ TEST(ScheduleBuilderTest, AllSessionTypes) {
 
     vector<InformativeSchedule> result = builder.build({course});
     ASSERT_EQ(result.size(), 1);  // Should handle all session types
-}
\ No newline at end of file
+}
+
+// Sessions off the 5-minute grid fall back to exact time comparison
+TEST(ScheduleBuilderTest, OffGridTimes_TouchingDoNotConflict) {
+    ScheduleBuilder builder;
+
+    vector<Session> lectureSessionsA = {makeTestSession(1, "09:02", "10:58")};
+    Group lectureGroupA = makeGroup(SessionType::LECTURE, lectureSessionsA);
+    Course courseA = makeCourse(1601, {lectureGroupA});
+
+    vector<Session> lectureSessionsB = {makeTestSession(1, "10:58", "11:30")};
+    Group lectureGroupB = makeGroup(SessionType::LECTURE, lectureSessionsB);
+    Course courseB = makeCourse(1602, {lectureGroupB});
+
+    vector<Session> lectureSessionsC = {makeTestSession(1, "10:57", "11:00")};
+    Group lectureGroupC = makeGroup(SessionType::LECTURE, lectureSessionsC);
+    Course courseC = makeCourse(1603, {lectureGroupC});
+
+    ASSERT_EQ(builder.build({courseA, courseB}).size(), 1);  // Touching at 10:58 is not a conflict
+    ASSERT_EQ(builder.build({courseA, courseC}).size(), 0);  // One shared minute is a conflict
+}
+
+// Parallel search returns the same schedules, in the same order, as the sequential search
+// Courses with a lecture on each of five days and a tutorial on each of three, no two courses overlapping
+static vector<Course> makeStaggeredCourses(int count) {
+    vector<Course> courses;
+    for (int c = 0; c < count; ++c) {
+        vector<Group> lectures;
+        for (int day = 1; day <= 5; ++day) {
+            string start = to_string(8 + c * 2) + ":00";
+            string end = to_string(9 + c * 2) + ":30";
+            lectures.push_back(makeGroup(SessionType::LECTURE, {makeTestSession(day, start, end)}));
+        }
+        vector<Group> tutorials;
+        for (int day = 1; day <= 3; ++day) {
+            string start = to_string(16 + c) + ":00";
+            string end = to_string(17 + c) + ":00";
+            tutorials.push_back(makeGroup(SessionType::TUTORIAL, {makeTestSession(day, start, end)}));
+        }
+        courses.push_back(makeCourse(1700 + c, lectures, tutorials));
+    }
+    return courses;
+}
+
+TEST(ScheduleBuilderTest, ParallelSearchMatchesSequential) {
+    vector<Course> courses = makeStaggeredCourses(3);
+
+    ScheduleBuilder sequential;
+    vector<InformativeSchedule> expected = sequential.build(courses);
+
+    ScheduleBuilder parallel;
+    parallel.setThreadCount(4);
+    vector<InformativeSchedule> result = parallel.build(courses);
+
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(result.size(), expected.size());
+    for (size_t i = 0; i < result.size(); ++i) {
+        EXPECT_EQ(result[i].index, static_cast<int>(i));
+        EXPECT_EQ(result[i].amount_days, expected[i].amount_days);
+        EXPECT_EQ(result[i].gaps_time, expected[i].gaps_time);
+        for (size_t day = 0; day < result[i].week.size(); ++day) {
+            ASSERT_EQ(result[i].week[day].day_items.size(), expected[i].week[day].day_items.size());
+            for (size_t item = 0; item < result[i].week[day].day_items.size(); ++item) {
+                EXPECT_EQ(result[i].week[day].day_items[item].raw_id, expected[i].week[day].day_items[item].raw_id);
+                EXPECT_EQ(result[i].week[day].day_items[item].start_minutes, expected[i].week[day].day_items[item].start_minutes);
+            }
+        }
+    }
+}
+
+// Streamed batches add up to the regular result, in the same order and with running indices.
+// A slow receiver gets one batch at a time while the other threads go on searching.
+TEST(ScheduleBuilderTest, StreamedBatchesMatchFullBuild) {
+    vector<Course> courses = makeStaggeredCourses(3);
+
+    ScheduleBuilder full;
+    vector<InformativeSchedule> expected = full.build(courses);
+    ASSERT_FALSE(expected.empty());
+
+    for (int threads : {1, 4}) {
+        vector<InformativeSchedule> streamed;
+        size_t batches = 0;
+        atomic<bool> receiving{false};
+
+        ScheduleBuilder builder;
+        builder.setThreadCount(threads);
+        builder.setBatchCallback([&](ScheduleStore&& batch) {
+            EXPECT_FALSE(receiving.exchange(true));
+            if (batches % 50 == 0) this_thread::sleep_for(chrono::milliseconds(5));
+            receiving = false;
+
+            EXPECT_LE(batch.size(), 10u);
+            EXPECT_EQ(batch.firstIndex(), static_cast<int>(streamed.size()));
+            batches++;
+            for (const auto& schedule : batch.materializeAll()) {
+                streamed.push_back(schedule);
+            }
+            return true;
+        }, 10);
+
+        BuildOutcome outcome;
+        ScheduleStore rest = builder.buildStore(courses, &outcome);
+
+        EXPECT_TRUE(rest.empty());
+        EXPECT_EQ(outcome.delivered, expected.size());
+        EXPECT_EQ(batches, (expected.size() + 9) / 10);
+        ASSERT_EQ(streamed.size(), expected.size());
+        for (size_t i = 0; i < streamed.size(); ++i) {
+            EXPECT_EQ(streamed[i].index, static_cast<int>(i));
+            EXPECT_EQ(streamed[i].gaps_time, expected[i].gaps_time);
+            EXPECT_EQ(streamed[i].avg_start, expected[i].avg_start);
+        }
+    }
+}
+
+// A receiver that refuses a batch stops the search
+TEST(ScheduleBuilderTest, RefusedBatchStopsGeneration) {
+    vector<Course> courses = makeStaggeredCourses(3);
+
+    size_t batches = 0;
+    ScheduleBuilder builder;
+    builder.setBatchCallback([&](ScheduleStore&&) {
+        batches++;
+        return false;
+    }, 5);
+
+    BuildOutcome outcome;
+    ScheduleStore rest = builder.buildStore(courses, &outcome);
+
+    EXPECT_TRUE(rest.empty());
+    EXPECT_EQ(batches, 1u);
+    EXPECT_EQ(outcome.delivered, 5u);
+    EXPECT_TRUE(outcome.stopped);
+}
+
+// The store keeps a few bytes per schedule and expands each one to what a full build returns
+TEST(ScheduleBuilderTest, StoreMaterializesOnDemand) {
+    vector<Course> courses = makeStaggeredCourses(3);
+
+    ScheduleBuilder builder;
+    vector<InformativeSchedule> expected = builder.build(courses);
+    ScheduleStore store = builder.buildStore(courses);
+
+    ASSERT_EQ(store.size(), expected.size());
+    EXPECT_LT(store.memoryBytes() / store.size(), 64u);
+
+    for (size_t i = 0; i < store.size(); i += 97) {
+        InformativeSchedule schedule = store.materialize(i);
+        EXPECT_EQ(schedule.index, expected[i].index);
+        EXPECT_EQ(schedule.amount_days, store.metrics(i).amount_days);
+        EXPECT_EQ(schedule.amount_gaps, expected[i].amount_gaps);
+        EXPECT_EQ(schedule.avg_end, expected[i].avg_end);
+        ASSERT_EQ(schedule.week.size(), 7u);
+        for (size_t day = 0; day < 7; ++day) {
+            ASSERT_EQ(schedule.week[day].day_items.size(), expected[i].week[day].day_items.size());
+            for (size_t item = 0; item < schedule.week[day].day_items.size(); ++item) {
+                EXPECT_EQ(schedule.week[day].day_items[item].courseName, expected[i].week[day].day_items[item].courseName);
+                EXPECT_EQ(schedule.week[day].day_items[item].end_minutes, expected[i].week[day].day_items[item].end_minutes);
+            }
+        }
+    }
+}
+
+// Metrics computed from the sessions match the ones of the materialized schedule
+TEST(ScheduleBuilderTest, StoredMetricsMatchMaterializedSchedule) {
+    Course a = makeCourse(1801, {makeGroup(SessionType::LECTURE, {makeTestSession(2, "08:00", "10:00"),
+                                                                  makeTestSession(4, "12:00", "14:00")})});
+    Course b = makeCourse(1802, {makeGroup(SessionType::LECTURE, {makeTestSession(2, "11:00", "12:00")}),
+                                 makeGroup(SessionType::LECTURE, {makeTestSession(2, "15:30", "17:00")})});
+
+    ScheduleBuilder builder;
+    ScheduleStore store = builder.buildStore({a, b});
+    ASSERT_EQ(store.size(), 2u);
+
+    // Monday 08-10, 11-12 and Wednesday 12-14
+    EXPECT_EQ(store.metrics(0).amount_days, 2);
+    EXPECT_EQ(store.metrics(0).amount_gaps, 1);
+    EXPECT_EQ(store.metrics(0).gaps_time, 60);
+    EXPECT_EQ(store.metrics(0).avg_start, (8 * 60 + 12 * 60) / 2);
+    EXPECT_EQ(store.metrics(0).avg_end, (12 * 60 + 14 * 60) / 2);
+
+    // Monday 08-10, 15:30-17 and Wednesday 12-14
+    EXPECT_EQ(store.metrics(1).gaps_time, 330);
+    EXPECT_EQ(store.metrics(1).avg_end, (17 * 60 + 14 * 60) / 2);
+    EXPECT_EQ(store.materialize(1).gaps_time, 330);
+}
+
+// Courses with lectures and tutorials spread pseudo-randomly over the week
+static vector<Course> makeVariedCourses(unsigned seed, int count) {
+    auto next = [&seed](int range) {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<int>((seed >> 16) % range);
+    };
+    auto time = [](int minutes) {
+        int hour = minutes / 60, minute = minutes % 60;
+        return to_string(hour) + ":" + (minute < 10 ? "0" : "") + to_string(minute);
+    };
+    auto session = [&]() {
+        int day = 1 + next(6);
+        int start = 8 * 60 + 30 * next(20);
+        int end = start + 60 + 30 * next(4);
+        return makeTestSession(day, time(start), time(end));
+    };
+
+    vector<Course> courses;
+    for (int c = 0; c < count; ++c) {
+        vector<Group> lectures, tutorials;
+        int lectureCount = 2 + next(4);
+        for (int g = 0; g < lectureCount; ++g) {
+            lectures.push_back(makeGroup(SessionType::LECTURE, {session(), session()}));
+        }
+        int tutorialCount = next(4);
+        for (int g = 0; g < tutorialCount; ++g) {
+            tutorials.push_back(makeGroup(SessionType::TUTORIAL, {session()}));
+        }
+        courses.push_back(makeCourse(1900 + c, lectures, tutorials));
+    }
+    return courses;
+}
+
+static int metricValue(const InformativeSchedule& schedule, ScheduleMetric metric) {
+    switch (metric) {
+        case ScheduleMetric::AMOUNT_DAYS: return schedule.amount_days;
+        case ScheduleMetric::AMOUNT_GAPS: return schedule.amount_gaps;
+        case ScheduleMetric::GAPS_TIME:   return schedule.gaps_time;
+        case ScheduleMetric::AVG_START:   return schedule.avg_start;
+        case ScheduleMetric::AVG_END:     return schedule.avg_end;
+    }
+    return 0;
+}
+
+// Top-k matches ranking the full result, for every objective, sequentially and in parallel
+TEST(ScheduleBuilderTest, TopKMatchesFullRanking) {
+    const vector<ScheduleMetric> metrics = {ScheduleMetric::AMOUNT_DAYS, ScheduleMetric::AMOUNT_GAPS,
+                                            ScheduleMetric::GAPS_TIME, ScheduleMetric::AVG_START,
+                                            ScheduleMetric::AVG_END};
+    const size_t k = 7;
+
+    for (unsigned seed : {3u, 11u, 42u}) {
+        vector<Course> courses = makeVariedCourses(seed, 4);
+
+        ScheduleBuilder fullBuilder;
+        vector<InformativeSchedule> all = fullBuilder.build(courses);
+        if (all.size() <= k) continue;
+
+        for (ScheduleMetric metric : metrics) {
+            for (bool ascending : {true, false}) {
+                vector<InformativeSchedule> expected = all;
+                stable_sort(expected.begin(), expected.end(), [&](const InformativeSchedule& a, const InformativeSchedule& b) {
+                    int first = metricValue(a, metric), second = metricValue(b, metric);
+                    return ascending ? first < second : first > second;
+                });
+                expected.resize(k);
+
+                for (int threads : {1, 3}) {
+                    ScheduleBuilder builder;
+                    builder.setThreadCount(threads);
+                    ScheduleStore best = builder.buildTopK(courses, {metric, ascending}, k);
+
+                    ASSERT_EQ(best.size(), k);
+                    for (size_t i = 0; i < k; ++i) {
+                        InformativeSchedule schedule = best.materialize(i);
+                        EXPECT_EQ(schedule.index, static_cast<int>(i));
+                        EXPECT_EQ(metricValue(schedule, metric), metricValue(expected[i], metric));
+                        for (size_t day = 0; day < 7; ++day) {
+                            ASSERT_EQ(schedule.week[day].day_items.size(), expected[i].week[day].day_items.size());
+                            for (size_t item = 0; item < schedule.week[day].day_items.size(); ++item) {
+                                EXPECT_EQ(schedule.week[day].day_items[item].start_minutes, expected[i].week[day].day_items[item].start_minutes);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(ScheduleBuilderTest, TopKKeepsAllWhenFewerExist) {
+    vector<Course> courses = makeStaggeredCourses(1);
+
+    ScheduleBuilder builder;
+    ScheduleStore best = builder.buildTopK(courses, {ScheduleMetric::AVG_START, true}, 1000);
+
+    EXPECT_EQ(best.size(), builder.build(courses).size());
+    EXPECT_TRUE(builder.buildTopK(courses, {ScheduleMetric::AVG_START, true}, 0).empty());
+}
+
+// Flattens a schedule to compare schedules regardless of their index
+static string scheduleContent(const InformativeSchedule& schedule) {
+    string content;
+    for (const auto& day : schedule.week) {
+        for (const auto& item : day.day_items) {
+            content += day.day + " " + item.raw_id + " " + item.type + " " + TimeUtils::formatMinutes(item.start_minutes) + "-" +
+                       TimeUtils::formatMinutes(item.end_minutes) + ";";
+        }
+    }
+    return content;
+}
+
+// The front holds exactly the non-dominated schedules of the full result, one per score vector,
+// keeping the first schedule found and ordered by scores, sequentially and in parallel
+TEST(ScheduleBuilderTest, ParetoFrontMatchesDominanceFilter) {
+    const vector<vector<ScheduleObjective>> objectiveSets = {
+        {{ScheduleMetric::AMOUNT_DAYS, true}, {ScheduleMetric::GAPS_TIME, true}},
+        {{ScheduleMetric::AVG_START, false}, {ScheduleMetric::AVG_END, true}, {ScheduleMetric::AMOUNT_GAPS, true}},
+    };
+
+    for (unsigned seed : {3u, 11u, 42u}) {
+        vector<Course> courses = makeVariedCourses(seed, 4);
+        vector<InformativeSchedule> all = ScheduleBuilder().build(courses);
+        if (all.empty()) continue;
+
+        for (const auto& objectives : objectiveSets) {
+            auto scores = [&](const InformativeSchedule& schedule) {
+                vector<int> values;
+                for (const auto& objective : objectives) {
+                    int value = metricValue(schedule, objective.metric);
+                    values.push_back(objective.ascending ? value : -value);
+                }
+                return values;
+            };
+            auto dominates = [](const vector<int>& a, const vector<int>& b) {
+                bool strict = false;
+                for (size_t i = 0; i < a.size(); ++i) {
+                    if (a[i] > b[i]) return false;
+                    if (a[i] < b[i]) strict = true;
+                }
+                return strict;
+            };
+
+            vector<pair<vector<int>, string>> expected;
+            for (const auto& schedule : all) {
+                vector<int> values = scores(schedule);
+                bool kept = true;
+                for (const auto& other : all) {
+                    if (dominates(scores(other), values)) { kept = false; break; }
+                }
+                for (const auto& point : expected) {
+                    if (point.first == values) { kept = false; break; }
+                }
+                if (kept) expected.push_back({values, scheduleContent(schedule)});
+            }
+            stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+            for (int threads : {1, 3}) {
+                ScheduleBuilder builder;
+                builder.setThreadCount(threads);
+                ScheduleStore front = builder.buildParetoFront(courses, objectives);
+
+                ASSERT_EQ(front.size(), expected.size());
+                for (size_t i = 0; i < front.size(); ++i) {
+                    InformativeSchedule schedule = front.materialize(i);
+                    EXPECT_EQ(schedule.index, static_cast<int>(i));
+                    EXPECT_EQ(scores(schedule), expected[i].first);
+                    EXPECT_EQ(scheduleContent(schedule), expected[i].second);
+                }
+            }
+        }
+    }
+
+    EXPECT_TRUE(ScheduleBuilder().buildParetoFront(makeStaggeredCourses(1), {}).empty());
+}
+
+// The courses are searched fewest options first, so their input order does not change the schedules found
+TEST(ScheduleBuilderTest, CourseOrderDoesNotChangeSchedules) {
+    vector<Course> courses = makeVariedCourses(3, 4);
+    vector<Course> reversed(courses.rbegin(), courses.rend());
+
+    ScheduleBuilder builder;
+    vector<string> forward, backward;
+    for (const auto& schedule : builder.build(courses)) forward.push_back(scheduleContent(schedule));
+    for (const auto& schedule : builder.build(reversed)) backward.push_back(scheduleContent(schedule));
+
+    ASSERT_FALSE(forward.empty());
+    sort(forward.begin(), forward.end());
+    sort(backward.begin(), backward.end());
+    EXPECT_EQ(forward, backward);
+}
+
+// Counting agrees with a full build, including inputs without any valid schedule
+TEST(ScheduleBuilderTest, CountMatchesBuild) {
+    for (unsigned seed : {3u, 7u, 11u, 42u}) {
+        for (int count : {1, 3, 5}) {
+            vector<Course> courses = makeVariedCourses(seed, count);
+
+            ScheduleBuilder builder;
+            EXPECT_EQ(builder.countSchedules(courses), builder.buildStore(courses).size());
+        }
+    }
+
+    ScheduleBuilder builder;
+    EXPECT_EQ(builder.countSchedules(makeStaggeredCourses(4)), builder.buildStore(makeStaggeredCourses(4)).size());
+
+    // Under constraints the count is of the schedules the build keeps
+    ScheduleConstraints constraints;
+    constraints.maxDays = 4;
+    constraints.earliestStart = 9 * 60;
+    builder.setConstraints(constraints);
+    for (unsigned seed : {3u, 11u}) {
+        vector<Course> courses = makeVariedCourses(seed, 4);
+        EXPECT_EQ(builder.countSchedules(courses), builder.buildStore(courses).size());
+    }
+}
+
+// A result budget keeps the first schedules of the search, with and without streaming or threads
+TEST(ScheduleBuilderTest, ResultBudgetKeepsFirstSchedules) {
+    vector<Course> courses = makeStaggeredCourses(3);
+
+    ScheduleBuilder full;
+    ScheduleStore expected = full.buildStore(courses);
+    ASSERT_GT(expected.size(), 100u);
+    EXPECT_FALSE(expected.truncated());
+
+    for (int threads : {1, 3}) {
+        for (bool streaming : {false, true}) {
+            ScheduleStore kept;
+
+            ScheduleBuilder builder;
+            builder.setThreadCount(threads);
+            builder.setBudget({100, 0, std::chrono::milliseconds(0)});
+            if (streaming) {
+                builder.setBatchCallback([&](ScheduleStore&& batch) {
+                    kept.append(batch);
+                    return true;
+                }, 16);
+            }
+
+            BuildOutcome outcome;
+            ScheduleStore rest = builder.buildStore(courses, &outcome);
+            kept.append(rest);
+
+            EXPECT_TRUE(outcome.truncated);
+            EXPECT_TRUE(rest.truncated());
+            ASSERT_EQ(kept.size(), 100u);
+            for (size_t i = 0; i < kept.size(); ++i) {
+                EXPECT_EQ(scheduleContent(kept.materialize(i)), scheduleContent(expected.materialize(i)));
+            }
+        }
+    }
+
+    // A budget the result fits in does not truncate it
+    ScheduleBuilder exact;
+    exact.setThreadCount(3);
+    exact.setBudget({expected.size(), 0, std::chrono::milliseconds(0)});
+    BuildOutcome outcome;
+    EXPECT_EQ(exact.buildStore(courses, &outcome).size(), expected.size());
+    EXPECT_FALSE(outcome.truncated);
+}
+
+// Parallel tasks only keep what the earlier tasks leave of the limit, the kept schedules stay the first ones
+TEST(ScheduleBuilderTest, ParallelResultBudgetKeepsFirstSchedules) {
+    vector<Course> courses = makeStaggeredCourses(4);
+    ScheduleStore expected = ScheduleBuilder().buildStore(courses);
+
+    for (size_t limit : {size_t(1), size_t(37), expected.size() / 3, expected.size() - 1}) {
+        ScheduleBuilder builder;
+        builder.setThreadCount(8);
+        builder.setBudget({limit, 0, std::chrono::milliseconds(0)});
+        ScheduleStore kept = builder.buildStore(courses);
+
+        EXPECT_TRUE(kept.truncated());
+        ASSERT_EQ(kept.size(), limit);
+        for (size_t i = 0; i < kept.size(); ++i) {
+            EXPECT_EQ(scheduleContent(kept.materialize(i)), scheduleContent(expected.materialize(i))) << limit;
+        }
+    }
+}
+
+TEST(ScheduleBuilderTest, MemoryBudgetLimitsStoredSchedules) {
+    vector<Course> courses = makeStaggeredCourses(3);
+    size_t bytesPerSchedule = ScheduleBuilder().buildStore(courses).bytesPerSchedule();
+
+    ScheduleBuilder builder;
+    builder.setBudget({0, 40 * bytesPerSchedule, std::chrono::milliseconds(0)});
+    ScheduleStore kept = builder.buildStore(courses);
+
+    EXPECT_EQ(kept.size(), 40u);
+    EXPECT_TRUE(kept.truncated());
+}
+
+// Twelve courses of three options each, none overlapping: 3^12 schedules
+TEST(ScheduleBuilderTest, TimeBudgetStopsLargeSelection) {
+    vector<Course> courses;
+    for (int c = 0; c < 12; ++c) {
+        vector<Group> lectures;
+        for (int day = 1; day <= 3; ++day) {
+            lectures.push_back(makeGroup(SessionType::LECTURE,
+                                         {makeTestSession(day, to_string(8 + c) + ":00", to_string(8 + c) + ":50")}));
+        }
+        courses.push_back(makeCourse(2000 + c, lectures, {}));
+    }
+
+    ScheduleBuilder builder;
+    builder.setBudget({0, 0, std::chrono::milliseconds(1)});
+    ScheduleStore kept = builder.buildStore(courses);
+
+    EXPECT_TRUE(kept.truncated());
+    EXPECT_LT(kept.size(), 531441u);
+}
+
+// Blocked times leave out the options overlapping them, as a course of blocks would, without adding items
+TEST(ScheduleBuilderTest, BlockedTimesMatchBlockCourse) {
+    vector<Course> courses = makeVariedCourses(3, 4);
+    vector<Session> blocked = {makeTestSession(2, "10:00", "12:00"), makeTestSession(4, "13:10", "14:00")};
+
+    vector<Course> withBlockCourse = courses;
+    withBlockCourse.push_back(makeCourse(90000, {}, {}, {}, {makeGroup(SessionType::BLOCK, blocked)}));
+
+    ScheduleBuilder builder;
+    size_t expected = builder.buildStore(withBlockCourse).size();
+    size_t unblocked = builder.buildStore(courses).size();
+
+    builder.setBlockedTimes(blocked);
+    vector<InformativeSchedule> schedules = builder.build(courses);
+
+    EXPECT_EQ(schedules.size(), expected);
+    EXPECT_LT(schedules.size(), unblocked);
+    EXPECT_EQ(builder.countSchedules(courses), expected);
+    for (const auto& schedule : schedules) {
+        for (const auto& day : schedule.week) {
+            for (const auto& item : day.day_items) {
+                EXPECT_NE(item.type, "Block");
+            }
+        }
+    }
+}
+
+// Groups meeting at the same times in other rooms become variants of one schedule, which together
+// cover every schedule of the uncollapsed build
+TEST(ScheduleBuilderTest, SameTimeOptionsCollapseIntoVariants) {
+    Course rooms = makeCourse(4100,
+                              {makeGroup(SessionType::LECTURE, {makeTestSession(1, "08:00", "10:00", "1", "101")}),
+                               makeGroup(SessionType::LECTURE, {makeTestSession(1, "08:00", "10:00", "2", "202")}),
+                               makeGroup(SessionType::LECTURE, {makeTestSession(2, "08:00", "10:00", "1", "101")})},
+                              {makeGroup(SessionType::TUTORIAL, {makeTestSession(3, "12:00", "13:00", "3", "303")}),
+                               makeGroup(SessionType::TUTORIAL, {makeTestSession(3, "12:00", "13:00", "4", "404")})});
+    vector<Course> courses = {rooms, makeVariedCourses(5, 1)[0]};
+    auto withRooms = [](const InformativeSchedule& schedule) {
+        string content = scheduleContent(schedule);
+        for (const auto& day : schedule.week) {
+            for (const auto& item : day.day_items) content += item.building + "/" + item.room + ";";
+        }
+        return content;
+    };
+
+    ScheduleBuilder builder;
+    ScheduleStore all = builder.buildStore(courses);
+
+    builder.setCollapseSameTimeOptions(true);
+    ScheduleStore collapsed = builder.buildStore(courses);
+    EXPECT_EQ(builder.countSchedules(courses), collapsed.size());
+    ASSERT_LT(collapsed.size(), all.size());
+
+    vector<string> expanded;
+    for (size_t position = 0; position < collapsed.size(); ++position) {
+        for (size_t variant = 0; variant < collapsed.variantCount(position); ++variant) {
+            InformativeSchedule schedule = collapsed.materialize(position, variant);
+            EXPECT_EQ(schedule.gaps_time, collapsed.metrics(position).gaps_time);
+            expanded.push_back(withRooms(schedule));
+        }
+    }
+    vector<string> expected;
+    for (size_t position = 0; position < all.size(); ++position) {
+        expected.push_back(withRooms(all.materialize(position)));
+    }
+    sort(expanded.begin(), expanded.end());
+    sort(expected.begin(), expected.end());
+    EXPECT_EQ(expanded, expected);
+}
+
+// The progress only grows and ends at 1 when the search runs to its end
+TEST(ScheduleBuilderTest, ProgressEndsAtOne) {
+    vector<double> reports;
+    ScheduleBuilder builder;
+    builder.setProgressCallback([&](double explored) { reports.push_back(explored); });
+    builder.buildStore(makeStaggeredCourses(6));
+
+    ASSERT_FALSE(reports.empty());
+    EXPECT_TRUE(is_sorted(reports.begin(), reports.end()));
+    EXPECT_DOUBLE_EQ(reports.back(), 1.0);
+}
+
+TEST(ScheduleBuilderTest, CancellationStopsSearch) {
+    vector<Course> courses;
+    for (int c = 0; c < 12; ++c) {
+        vector<Group> lectures;
+        for (int day = 1; day <= 3; ++day) {
+            lectures.push_back(makeGroup(SessionType::LECTURE,
+                                         {makeTestSession(day, to_string(8 + c) + ":00", to_string(8 + c) + ":50")}));
+        }
+        courses.push_back(makeCourse(2000 + c, lectures, {}));
+    }
+
+    auto token = make_shared<CancellationToken>();
+    vector<double> reports;
+
+    ScheduleBuilder builder;
+    builder.setCancellation(token);
+    builder.setProgressCallback([&](double explored) {
+        reports.push_back(explored);
+        token->cancel();
+    });
+    BuildOutcome outcome;
+    ScheduleStore kept = builder.buildStore(courses, &outcome);
+
+    EXPECT_TRUE(outcome.stopped);
+    EXPECT_LT(kept.size(), 531441u);
+    ASSERT_EQ(reports.size(), 1u);
+    EXPECT_LT(reports.front(), 1.0);
+
+    // A cancelled token stops the next build before it generates any options
+    ScheduleStore cancelled = builder.buildStore(makeStaggeredCourses(3));
+    EXPECT_TRUE(cancelled.empty());
+    ASSERT_TRUE(cancelled.catalog());
+    for (const auto& options : cancelled.catalog()->options) {
+        EXPECT_TRUE(options.empty());
+    }
+}
+
+static vector<string> storeContents(const ScheduleStore& store) {
+    vector<string> contents;
+    for (size_t i = 0; i < store.size(); ++i) {
+        contents.push_back(scheduleContent(store.materialize(i)));
+        EXPECT_EQ(store.materialize(i).gaps_time, store.metrics(i).gaps_time);
+    }
+    return contents;
+}
+
+static vector<string> sortedContents(const ScheduleStore& store) {
+    vector<string> contents = storeContents(store);
+    sort(contents.begin(), contents.end());
+    return contents;
+}
+
+// Adding a course extends the previous schedules, removing one searches again; both match a fresh build, in order
+TEST(ScheduleBuilderTest, RebuildMatchesFreshBuild) {
+    vector<Course> all = makeVariedCourses(3, 4);
+    vector<Course> withoutSecond = {all[0], all[2], all[3]};
+
+    ScheduleBuilder builder;
+    ScheduleStore fewer = builder.buildStore(withoutSecond);
+    ScheduleStore expected = builder.buildStore(all);
+    ASSERT_FALSE(expected.empty());
+
+    BuildOutcome outcome;
+    ScheduleStore extended = builder.rebuildStore(fewer, all, &outcome);
+    EXPECT_TRUE(outcome.reused);
+    EXPECT_EQ(storeContents(extended), storeContents(expected));
+
+    ScheduleStore reduced = builder.rebuildStore(expected, withoutSecond, &outcome);
+    EXPECT_FALSE(outcome.reused);
+    EXPECT_EQ(storeContents(reduced), storeContents(fewer));
+
+    // The search takes the most constrained course first, the extension must still number schedules like it
+    vector<Course> staggered = makeStaggeredCourses(4);
+    vector<Course> withoutFirst(staggered.begin() + 1, staggered.end());
+    ScheduleStore staggeredExtended = builder.rebuildStore(builder.buildStore(withoutFirst), staggered, &outcome);
+    EXPECT_TRUE(outcome.reused);
+    EXPECT_EQ(storeContents(staggeredExtended), storeContents(builder.buildStore(staggered)));
+
+    // A changed course is not the same course, it is the one added
+    vector<Course> changed = all;
+    changed[1].Lectures.pop_back();
+    ScheduleStore changedExtended = builder.rebuildStore(fewer, changed, &outcome);
+    EXPECT_TRUE(outcome.reused);
+    EXPECT_EQ(storeContents(changedExtended), storeContents(builder.buildStore(changed)));
+    changed[0].Lectures.pop_back();
+    ScheduleStore changedSearched = builder.rebuildStore(fewer, changed, &outcome);
+    EXPECT_FALSE(outcome.reused);
+    EXPECT_EQ(storeContents(changedSearched), storeContents(builder.buildStore(changed)));
+}
+
+// Builds running at once on one builder each report their own outcome
+TEST(ScheduleBuilderTest, ConcurrentBuildsReportTheirOwnOutcome) {
+    vector<Course> all = makeVariedCourses(3, 4);
+    vector<Course> withoutSecond = {all[0], all[2], all[3]};
+
+    ScheduleBuilder builder;
+    ScheduleStore fewer = builder.buildStore(withoutSecond);
+
+    atomic<int> wrong{0};
+    thread rebuilding([&]() {
+        for (int i = 0; i < 20; ++i) {
+            BuildOutcome outcome;
+            builder.rebuildStore(fewer, all, &outcome);
+            if (!outcome.reused) wrong++;
+        }
+    });
+    for (int i = 0; i < 20; ++i) {
+        BuildOutcome outcome;
+        builder.buildStore(all, &outcome);
+        if (outcome.reused) wrong++;
+    }
+    rebuilding.join();
+
+    EXPECT_EQ(wrong, 0);
+}
+
+// Checks a finished schedule against constraints the way a filter run afterwards would
+static bool meetsConstraints(const InformativeSchedule& schedule, const ScheduleConstraints& constraints) {
+    int gaps = 0, longestGap = 0;
+    for (const auto& day : schedule.week) {
+        vector<pair<int, int>> items;
+        for (const auto& item : day.day_items) {
+            items.emplace_back(item.start_minutes, item.end_minutes);
+            if (constraints.earliestStart >= 0 && items.back().first < constraints.earliestStart) return false;
+        }
+        stable_sort(items.begin(), items.end(), [](const pair<int, int>& a, const pair<int, int>& b) {
+            return a.first < b.first;
+        });
+        for (size_t i = 0; i + 1 < items.size(); ++i) {
+            int duration = items[i + 1].first - items[i].second;
+            if (duration >= MIN_GAP_MINUTES) {
+                gaps++;
+                longestGap = max(longestGap, duration);
+            }
+        }
+    }
+
+    if (constraints.maxDays >= 0 && schedule.amount_days > constraints.maxDays) return false;
+    if (constraints.maxGaps >= 0 && gaps > constraints.maxGaps) return false;
+    if (constraints.maxGapMinutes >= 0 && longestGap > constraints.maxGapMinutes) return false;
+    if (schedule.amount_days == 0) return true;
+    if (constraints.minAvgStart >= 0 && schedule.avg_start < constraints.minAvgStart) return false;
+    if (constraints.maxAvgEnd >= 0 && schedule.avg_end > constraints.maxAvgEnd) return false;
+    return true;
+}
+
+// Constraints cut the search down to exactly the schedules filtering the full result would keep.
+// Options dropped before the search may change the course order, so the schedules are compared sorted.
+TEST(ScheduleBuilderTest, ConstraintsMatchFilteringAfterwards) {
+    vector<ScheduleConstraints> constraintSets(6);
+    constraintSets[0].maxDays = 3;
+    constraintSets[1].maxGaps = 2;
+    constraintSets[2].maxGapMinutes = 90;
+    constraintSets[3].earliestStart = 9 * 60;
+    constraintSets[4].minAvgStart = 10 * 60;
+    constraintSets[5].maxAvgEnd = 13 * 60;
+    constraintSets[5].maxDays = 4;
+
+    for (unsigned seed : {3u, 11u, 42u}) {
+        vector<Course> courses = makeVariedCourses(seed, 4);
+        ScheduleBuilder fullBuilder;
+        ScheduleStore all = fullBuilder.buildStore(courses);
+
+        for (const auto& constraints : constraintSets) {
+            vector<string> expected;
+            for (size_t i = 0; i < all.size(); ++i) {
+                InformativeSchedule schedule = all.materialize(i);
+                if (meetsConstraints(schedule, constraints)) expected.push_back(scheduleContent(schedule));
+            }
+            sort(expected.begin(), expected.end());
+
+            for (int threads : {1, 3}) {
+                ScheduleBuilder builder;
+                builder.setThreadCount(threads);
+                builder.setConstraints(constraints);
+                ScheduleStore kept = builder.buildStore(courses);
+
+                vector<string> contents;
+                for (size_t i = 0; i < kept.size(); ++i) {
+                    contents.push_back(scheduleContent(kept.materialize(i)));
+                }
+                sort(contents.begin(), contents.end());
+                EXPECT_EQ(contents, expected) << "seed " << seed << ", " << threads << " threads";
+            }
+        }
+    }
+}
+
+// Builds running at once on one builder keep their own state, each matches the same build run alone
+TEST(ScheduleBuilderTest, ConcurrentBuildsShareOneBuilder) {
+    ScheduleBuilder builder;
+    builder.setThreadCount(2);
+
+    vector<vector<Course>> selections;
+    vector<vector<string>> expected;
+    for (unsigned seed : {3u, 11u, 42u, 7u}) {
+        selections.push_back(makeVariedCourses(seed, 4));
+        expected.push_back(sortedContents(builder.buildStore(selections.back())));
+    }
+
+    vector<ScheduleStore> stores(selections.size());
+    vector<size_t> counts(selections.size());
+    vector<thread> threads;
+    for (size_t i = 0; i < selections.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            stores[i] = i % 2 == 0 ? builder.buildStore(selections[i]) : builder.rebuildStore(ScheduleStore(), selections[i]);
+            counts[i] = builder.countSchedules(selections[i]);
+        });
+    }
+    for (auto& worker : threads) {
+        worker.join();
+    }
+
+    for (size_t i = 0; i < selections.size(); ++i) {
+        EXPECT_EQ(sortedContents(stores[i]), expected[i]);
+        EXPECT_EQ(counts[i], expected[i].size());
+    }
+}
+
+// Samples are different schedules of the full build in its order, the same seed drawing the same ones
+TEST(ScheduleBuilderTest, SamplesAreDistinctSchedulesOfTheBuild) {
+    vector<Course> courses = makeStaggeredCourses(3);
+
+    ScheduleBuilder builder;
+    ScheduleStore all = builder.buildStore(courses);
+    ASSERT_GT(all.size(), 50u);
+
+    vector<string> contents;
+    for (size_t i = 0; i < all.size(); ++i) contents.push_back(scheduleContent(all.materialize(i)));
+
+    ScheduleStore sample = builder.sampleSchedules(courses, 20, 42);
+    ASSERT_EQ(sample.size(), 20u);
+
+    size_t previous = 0;
+    for (size_t i = 0; i < sample.size(); ++i) {
+        auto found = find(contents.begin(), contents.end(), scheduleContent(sample.materialize(i)));
+        ASSERT_NE(found, contents.end());
+        size_t position = found - contents.begin();
+        if (i > 0) {
+            EXPECT_GT(position, previous);
+        }
+        previous = position;
+        EXPECT_EQ(sample.metrics(i).gaps_time, all.metrics(position).gaps_time);
+        EXPECT_EQ(sample.metrics(i).avg_end, all.metrics(position).avg_end);
+    }
+
+    EXPECT_EQ(sortedContents(builder.sampleSchedules(courses, 20, 42)), sortedContents(sample));
+    EXPECT_NE(sortedContents(builder.sampleSchedules(courses, 20, 43)), sortedContents(sample));
+
+    // Asking for more than there are gives all of them, in build order
+    ScheduleStore everything = builder.sampleSchedules(courses, all.size() + 5, 1);
+    ASSERT_EQ(everything.size(), all.size());
+    for (size_t i = 0; i < all.size(); ++i) {
+        EXPECT_EQ(scheduleContent(everything.materialize(i)), contents[i]);
+    }
+}
+
+// Every schedule is about as likely to be drawn as any other
+TEST(ScheduleBuilderTest, SamplesAreUniform) {
+    vector<Course> courses = makeVariedCourses(11, 3);
+
+    ScheduleBuilder builder;
+    ScheduleStore all = builder.buildStore(courses);
+    ASSERT_GT(all.size(), 4u);
+    ASSERT_LT(all.size(), 200u);
+
+    map<string, int> draws;
+    const int rounds = 200 * static_cast<int>(all.size());
+    for (int seed = 0; seed < rounds; seed++) {
+        ScheduleStore sample = builder.sampleSchedules(courses, 1, seed);
+        ASSERT_EQ(sample.size(), 1u);
+        draws[scheduleContent(sample.materialize(0))]++;
+    }
+
+    EXPECT_EQ(draws.size(), all.size());
+    for (const auto& [content, count] : draws) {
+        EXPECT_GT(count, 120) << content;
+        EXPECT_LT(count, 280) << content;
+    }
+}
+
+// Samples keep to an earliest start and are refused under limits on the metrics they cannot apply
+TEST(ScheduleBuilderTest, SamplesOnlyTakeTheEarliestStart) {
+    vector<Course> courses = makeVariedCourses(11, 3);
+
+    ScheduleBuilder builder;
+    ScheduleConstraints constraints;
+    constraints.earliestStart = 9 * 60;
+    builder.setConstraints(constraints);
+    size_t count = builder.countSchedules(courses);
+    ASSERT_GT(count, 0u);
+
+    ScheduleStore sample = builder.sampleSchedules(courses, count, 7);
+    EXPECT_EQ(sample.size(), count);
+    for (size_t i = 0; i < sample.size(); ++i) {
+        EXPECT_TRUE(meetsConstraints(sample.materialize(i), constraints));
+    }
+
+    constraints.maxDays = 4;
+    builder.setConstraints(constraints);
+    ASSERT_GT(builder.countSchedules(courses), 0u);
+    EXPECT_TRUE(builder.sampleSchedules(courses, 5, 7).empty());
+}
@@ -0,0 +1,148 @@
+#include "schedule_filter.h"
+#include "ScheduleBuilder.h"
+#include "gtest/gtest.h"
+#include "test_helpers.h"
+
+using namespace std;
+
+// Courses with lectures and tutorials spread over the week and the day
+static vector<Course> makeSpreadCourses(int count) {
+    vector<Course> courses;
+    for (int c = 0; c < count; ++c) {
+        Course course;
+        course.id = 40000 + c;
+        course.raw_id = to_string(course.id);
+        course.name = "Course " + course.raw_id;
+        for (int g = 0; g < 3; ++g) {
+            int day = 1 + (c + 2 * g) % 6;
+            int hour = 8 + (3 * c + 2 * g) % 10;
+            Group lecture;
+            lecture.type = SessionType::LECTURE;
+            lecture.sessions.push_back(makeSession(day, to_string(hour) + ":00", to_string(hour + 2) + ":00"));
+            course.Lectures.push_back(lecture);
+
+            Group tutorial;
+            tutorial.type = SessionType::TUTORIAL;
+            int tutorialHour = 8 + (c + 5 * g) % 11;
+            tutorial.sessions.push_back(makeSession(1 + (day + g) % 6, to_string(tutorialHour) + ":30",
+                                                    to_string(tutorialHour + 1) + ":30"));
+            course.Tirgulim.push_back(tutorial);
+        }
+        courses.push_back(course);
+    }
+    return courses;
+}
+
+static string weekContent(const InformativeSchedule& schedule) {
+    string content;
+    for (const auto& day : schedule.week) {
+        for (const auto& item : day.day_items) {
+            content += item.raw_id + item.type + to_string(item.start_minutes) + "-" + to_string(item.end_minutes) + ";";
+        }
+        content += "|";
+    }
+    return content;
+}
+
+// --- TEST CASES ---
+
+// Filter criteria passed to the generation as constraints keep exactly the schedules the filter keeps afterwards
+TEST(ScheduleFilterTest, ConstraintsKeepWhatTheFilterKeeps) {
+    vector<ScheduleFilter::FilterCriteria> criteriaSets(6);
+    criteriaSets[0].daysToStudyEnabled = true;
+    criteriaSets[0].daysToStudyValue = 4;
+    criteriaSets[1].totalGapsEnabled = true;
+    criteriaSets[1].totalGapsValue = 2;
+    criteriaSets[2].maxGapsTimeEnabled = true;
+    criteriaSets[2].maxGapsTimeValue = 120;
+    criteriaSets[3].earliestStartEnabled = true;
+    criteriaSets[3].earliestStartHour = 9;
+    criteriaSets[4].avgDayStartEnabled = true;
+    criteriaSets[4].avgDayStartHour = 10;
+    criteriaSets[4].avgDayEndEnabled = true;
+    criteriaSets[4].avgDayEndHour = 15;
+    criteriaSets[4].avgDayEndMinute = 30;
+    criteriaSets[5] = criteriaSets[0];
+    criteriaSets[5].earliestStartEnabled = true;
+    criteriaSets[5].earliestStartHour = 10;
+
+    vector<Course> courses = makeSpreadCourses(4);
+    vector<InformativeSchedule> all = ScheduleBuilder().build(courses);
+    ASSERT_FALSE(all.empty());
+
+    ScheduleFilter filter;
+    for (const auto& criteria : criteriaSets) {
+        vector<string> expected;
+        for (const auto& schedule : filter.filterSchedules(all, criteria)) expected.push_back(weekContent(schedule));
+        sort(expected.begin(), expected.end());
+
+        ScheduleBuilder builder;
+        builder.setConstraints(ScheduleFilter::toConstraints(criteria));
+        vector<string> kept;
+        for (const auto& schedule : builder.build(courses)) kept.push_back(weekContent(schedule));
+        sort(kept.begin(), kept.end());
+
+        EXPECT_EQ(kept, expected);
+        EXPECT_LT(kept.size(), all.size());
+    }
+
+    EXPECT_FALSE(ScheduleFilter::toConstraints({}).any());
+    EXPECT_EQ(ScheduleFilter::toConstraints(criteriaSets[5]).earliestStart, 10 * 60);
+}
+
+// Breaks shorter than MIN_GAP_MINUTES are not gaps for the filter, the constraints or the metrics
+TEST(ScheduleFilterTest, ShortBreaksAreNotGaps) {
+    Course first;
+    first.id = 41000;
+    first.raw_id = "41000";
+    first.name = "First";
+    Group lecture;
+    lecture.type = SessionType::LECTURE;
+    lecture.sessions.push_back(makeSession(2, "8:00", "9:00"));
+    first.Lectures.push_back(lecture);
+
+    Course second;
+    second.id = 41001;
+    second.raw_id = "41001";
+    second.name = "Second";
+    for (const auto& times : vector<pair<string, string>>{{"9:15", "10:15"}, {"9:20", "10:00"}, {"9:45", "10:45"}}) {
+        Group group;
+        group.type = SessionType::LECTURE;
+        group.sessions.push_back(makeSession(2, times.first, times.second));
+        second.Lectures.push_back(group);
+    }
+
+    vector<Course> courses = {first, second};
+    vector<InformativeSchedule> all = ScheduleBuilder().build(courses);
+    ASSERT_EQ(all.size(), 3u);
+
+    ScheduleFilter::FilterCriteria noGaps;
+    noGaps.totalGapsEnabled = true;
+    noGaps.totalGapsValue = 0;
+    ScheduleFilter::FilterCriteria shortGaps;
+    shortGaps.maxGapsTimeEnabled = true;
+    shortGaps.maxGapsTimeValue = 30;
+
+    ScheduleFilter filter;
+    for (const auto& criteria : {noGaps, shortGaps}) {
+        // A day here has one gap at most, so the gap time is also the longest gap
+        for (const auto& schedule : all) {
+            bool withinMetrics = criteria.totalGapsEnabled ? schedule.amount_gaps <= criteria.totalGapsValue
+                                                           : schedule.gaps_time <= criteria.maxGapsTimeValue;
+            EXPECT_EQ(ScheduleFilter::meetsTotalGapsCriteria(schedule, criteria) &&
+                      ScheduleFilter::meetsMaxGapsTimeCriteria(schedule, criteria), withinMetrics);
+        }
+
+        // The 15 and 20 minute breaks pass, the 45 minute gap does not
+        vector<InformativeSchedule> expected = filter.filterSchedules(all, criteria);
+        EXPECT_EQ(expected.size(), 2u);
+
+        ScheduleBuilder builder;
+        builder.setConstraints(ScheduleFilter::toConstraints(criteria));
+        vector<InformativeSchedule> kept = builder.build(courses);
+        ASSERT_EQ(kept.size(), expected.size());
+        for (size_t i = 0; i < kept.size(); ++i) {
+            EXPECT_EQ(weekContent(kept[i]), weekContent(expected[i]));
+        }
+    }
+}
@@ -0,0 +1,157 @@
+#include "ScheduleRanking.h"
+#include "gtest/gtest.h"
+#include "test_helpers.h"
+
+#include <array>
+#include <cfloat>
+#include <numeric>
+#include <random>
+
+using namespace std;
+
+// A store of schedules with random metrics and no courses, enough to rank
+static ScheduleStore makeMetricsStore(size_t count, unsigned seed) {
+    mt19937 random(seed);
+    uniform_int_distribution<int> days(1, 6);
+    uniform_int_distribution<int> gaps(0, 8);
+    uniform_int_distribution<int> minutes(8 * 60, 20 * 60);
+
+    ScheduleStore store;
+    for (size_t i = 0; i < count; ++i) {
+        ScheduleMetrics metrics;
+        metrics.amount_days = static_cast<int16_t>(days(random));
+        metrics.amount_gaps = static_cast<int16_t>(gaps(random));
+        metrics.gaps_time = static_cast<int16_t>(30 * gaps(random));
+        metrics.avg_start = static_cast<int16_t>(minutes(random));
+        metrics.avg_end = static_cast<int16_t>(minutes(random));
+        store.add({}, metrics);
+    }
+    return store;
+}
+
+static array<float, ScheduleRanking::METRIC_COUNT> metricValues(const ScheduleMetrics& metrics) {
+    return {static_cast<float>(metrics.amount_days), static_cast<float>(metrics.amount_gaps),
+            static_cast<float>(metrics.gaps_time), static_cast<float>(metrics.avg_start),
+            static_cast<float>(metrics.avg_end)};
+}
+
+// Store positions fully sorted by weighted score of the metrics scaled to their range, ties by position.
+// Scores are summed the way the ranking sums them, so equal schedules tie exactly.
+static vector<size_t> expectedOrder(const ScheduleStore& store, const ScheduleRanking::Weights& weights) {
+    array<float, ScheduleRanking::METRIC_COUNT> lowest, highest;
+    lowest.fill(FLT_MAX);
+    highest.fill(-FLT_MAX);
+    for (size_t position = 0; position < store.size(); ++position) {
+        auto values = metricValues(store.metrics(position));
+        for (int metric = 0; metric < ScheduleRanking::METRIC_COUNT; ++metric) {
+            lowest[metric] = min(lowest[metric], values[metric]);
+            highest[metric] = max(highest[metric], values[metric]);
+        }
+    }
+
+    vector<float> scores(store.size(), 0.0f);
+    for (int metric = 0; metric < ScheduleRanking::METRIC_COUNT; ++metric) {
+        float range = highest[metric] - lowest[metric];
+        if (weights[metric] == 0.0f || range == 0.0f) continue;
+        float factor = weights[metric] / range;
+        for (size_t position = 0; position < store.size(); ++position) {
+            scores[position] += factor * (metricValues(store.metrics(position))[metric] - lowest[metric]);
+        }
+    }
+
+    vector<size_t> order(store.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return scores[a] < scores[b]; });
+    return order;
+}
+
+// --- TEST CASES ---
+
+// The sorted part of the order always matches a full sort, however far it is extended
+TEST(ScheduleRankingTest, SortedPrefixMatchesFullSort) {
+    ScheduleStore store = makeMetricsStore(5000, 7);
+    ScheduleRanking ranking;
+    ranking.assign(store);
+
+    for (const ScheduleRanking::Weights& weights : {ScheduleRanking::Weights{1, 0, 0, 0, 0},
+                                                   ScheduleRanking::Weights{0, 0, 0, -1, 0},
+                                                   ScheduleRanking::Weights{60, 10, 1, 0, -2}}) {
+        vector<size_t> expected = expectedOrder(store, weights);
+
+        vector<size_t> order;
+        ranking.rank(weights, order, 20);
+        ASSERT_EQ(order.size(), store.size());
+        EXPECT_EQ(ranking.sortedCount(), 20u);
+        EXPECT_TRUE(equal(order.begin(), order.begin() + 20, expected.begin()));
+
+        ranking.sortUpTo(order, 10);
+        EXPECT_EQ(ranking.sortedCount(), 20u);
+        ranking.sortUpTo(order, 1500);
+        EXPECT_TRUE(equal(order.begin(), order.begin() + 1500, expected.begin()));
+        ranking.sortUpTo(order, SIZE_MAX);
+        EXPECT_EQ(order, expected);
+    }
+
+    vector<size_t> order;
+    ranking.reset(order);
+    EXPECT_FALSE(ranking.ranked());
+    EXPECT_EQ(order[4999], 4999u);
+}
+
+// Appended schedules better than the sorted ones move into the sorted part, which keeps matching a full sort
+TEST(ScheduleRankingTest, AppendedSchedulesMoveIntoSortedPart) {
+    const ScheduleRanking::Weights weights{0, 1, 0, 1, 0};
+
+    for (unsigned seed : {2u, 3u}) {
+        ScheduleStore store = makeMetricsStore(300, 1);
+        ScheduleRanking ranking;
+        ranking.assign(store);
+        vector<size_t> order;
+        ranking.rank(weights, order, 50);
+
+        // The first batch repeats metrics of the store, so the ranges stay; the second widens them
+        ScheduleStore more = makeMetricsStore(200, seed);
+        if (seed == 2u) {
+            more = ScheduleStore();
+            for (size_t position = 0; position < 200; ++position) more.add({}, store.metrics(299 - position));
+        } else {
+            ScheduleMetrics wide;
+            wide.amount_gaps = 20;
+            wide.avg_start = 2;
+            more.add({}, wide);
+        }
+
+        store.append(more);
+        EXPECT_TRUE(ranking.append(store, order));
+        ASSERT_EQ(order.size(), store.size());
+        EXPECT_EQ(ranking.sortedCount(), 50u);
+
+        vector<size_t> expected = expectedOrder(store, weights);
+        EXPECT_TRUE(equal(order.begin(), order.begin() + 50, expected.begin())) << seed;
+
+        ranking.sortUpTo(order, SIZE_MAX);
+        EXPECT_EQ(order, expected);
+    }
+}
+
+// Metrics are scaled to their range, so a small range such as the days is not outweighed by minutes
+TEST(ScheduleRankingTest, MetricsWeighTheirRange) {
+    ScheduleStore store;
+    ScheduleMetrics fewDaysLate;
+    fewDaysLate.amount_days = 1;
+    fewDaysLate.avg_start = 620;
+    ScheduleMetrics manyDaysEarly;
+    manyDaysEarly.amount_days = 5;
+    manyDaysEarly.avg_start = 590;
+    store.add({}, fewDaysLate);
+    store.add({}, manyDaysEarly);
+
+    ScheduleRanking ranking;
+    ranking.assign(store);
+    vector<size_t> order;
+    ranking.rank({2, 0, 0, 1, 0}, order, 2);
+    EXPECT_EQ(order, (vector<size_t>{0, 1}));
+
+    ranking.rank({1, 0, 0, 2, 0}, order, 2);
+    EXPECT_EQ(order, (vector<size_t>{1, 0}));
+}
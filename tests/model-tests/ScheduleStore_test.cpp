@@ -0,0 +1,144 @@
+#include "ScheduleStore.h"
+#include "ScheduleBuilder.h"
+#include "ScheduleSpillFile.h"
+#include "gtest/gtest.h"
+#include "test_helpers.h"
+
+using namespace std;
+
+// Courses with one lecture option per given day, at a different hour each
+static vector<Course> makeDayCourses(int count, int days) {
+    vector<Course> courses;
+    for (int c = 0; c < count; ++c) {
+        Course course;
+        course.id = 30000 + c;
+        course.raw_id = to_string(course.id);
+        course.name = "Course " + course.raw_id;
+        for (int day = 1; day <= days; ++day) {
+            Group group;
+            group.type = SessionType::LECTURE;
+            group.sessions.push_back(makeSession(day, to_string(8 + c) + ":00", to_string(8 + c) + ":50"));
+            course.Lectures.push_back(group);
+        }
+        courses.push_back(course);
+    }
+    return courses;
+}
+
+static void expectSameSchedules(const ScheduleStore& expected, const ScheduleStore& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t position = 0; position < expected.size(); ++position) {
+        EXPECT_EQ(expected.metrics(position).gaps_time, actual.metrics(position).gaps_time);
+        EXPECT_EQ(expected.metrics(position).avg_start, actual.metrics(position).avg_start);
+
+        InformativeSchedule first = expected.materialize(position);
+        InformativeSchedule second = actual.materialize(position);
+        for (size_t day = 0; day < first.week.size(); ++day) {
+            ASSERT_EQ(first.week[day].day_items.size(), second.week[day].day_items.size());
+            for (size_t item = 0; item < first.week[day].day_items.size(); ++item) {
+                EXPECT_EQ(first.week[day].day_items[item].raw_id, second.week[day].day_items[item].raw_id);
+                EXPECT_EQ(first.week[day].day_items[item].start_minutes, second.week[day].day_items[item].start_minutes);
+            }
+        }
+    }
+}
+
+// Spill file whose next remap fails once, after the records were already written
+class FailingRemapSpillFile : public ScheduleSpillFile {
+public:
+    using ScheduleSpillFile::ScheduleSpillFile;
+    bool failNextRemap = false;
+
+protected:
+    bool remap(size_t bytes) override {
+        if (failNextRemap) {
+            failNextRemap = false;
+            return false;
+        }
+        return ScheduleSpillFile::remap(bytes);
+    }
+};
+
+static vector<uint8_t> makeRecords(size_t count, size_t recordBytes, uint8_t first) {
+    vector<uint8_t> records(count * recordBytes);
+    for (size_t position = 0; position < count; ++position) {
+        fill_n(records.begin() + position * recordBytes, recordBytes, static_cast<uint8_t>(first + position));
+    }
+    return records;
+}
+
+// --- TEST CASES ---
+
+// Schedules moved to the temporary file read back the same as the ones kept in memory
+TEST(ScheduleStoreTest, SpilledSchedulesReadBackUnchanged) {
+    ScheduleBuilder builder;
+    ScheduleStore inMemory = builder.buildStore(makeDayCourses(3, 4));
+    ASSERT_EQ(inMemory.size(), 64u);
+
+    ScheduleStore spilled(inMemory.catalog());
+    spilled.setMemoryWindow(10);
+    for (size_t position = 0; position < inMemory.size(); ++position) {
+        spilled.addFrom(inMemory, position);
+    }
+
+    EXPECT_EQ(spilled.spilledSize(), 60u);
+    EXPECT_LT(spilled.memoryBytes(), inMemory.memoryBytes());
+    expectSameSchedules(inMemory, spilled);
+
+    // Appending a spilled store reads its file
+    ScheduleStore copied(inMemory.catalog());
+    copied.append(spilled);
+    expectSameSchedules(inMemory, copied);
+}
+
+// A copy keeps the schedules it had when copied, while the original keeps spilling
+TEST(ScheduleStoreTest, CopiesShareSpilledSchedules) {
+    ScheduleBuilder builder;
+    ScheduleStore all = builder.buildStore(makeDayCourses(3, 4));
+
+    ScheduleStore original(all.catalog());
+    original.setMemoryWindow(8);
+    for (size_t position = 0; position < 32; ++position) {
+        original.addFrom(all, position);
+    }
+
+    ScheduleStore copy = original;
+    for (size_t position = 32; position < all.size(); ++position) {
+        original.addFrom(all, position);
+        if (position < 48) copy.addFrom(all, all.size() - 1 - (position - 32));
+    }
+
+    expectSameSchedules(all, original);
+    ASSERT_EQ(copy.size(), 48u);
+    for (size_t position = 0; position < 32; ++position) {
+        EXPECT_EQ(copy.option(position, 0), all.option(position, 0));
+        EXPECT_EQ(copy.option(position, 2), all.option(position, 2));
+    }
+    for (size_t position = 32; position < 48; ++position) {
+        EXPECT_EQ(copy.option(position, 1), all.option(all.size() - 1 - (position - 32), 1));
+    }
+}
+
+// A failed remap drops the written records, the next append takes their place at the indexed offset
+TEST(ScheduleStoreTest, SpillFileAppendAfterFailedRemap) {
+    const size_t recordBytes = 16;
+    FailingRemapSpillFile file(recordBytes);
+    ASSERT_TRUE(file.isOpen());
+
+    vector<uint8_t> kept = makeRecords(3, recordBytes, 1);
+    ASSERT_TRUE(file.append(kept.data(), 3));
+
+    vector<uint8_t> dropped = makeRecords(2, recordBytes, 100);
+    file.failNextRemap = true;
+    EXPECT_FALSE(file.append(dropped.data(), 2));
+    EXPECT_EQ(file.size(), 3u);
+
+    vector<uint8_t> added = makeRecords(2, recordBytes, 4);
+    ASSERT_TRUE(file.append(added.data(), 2));
+    ASSERT_EQ(file.size(), 5u);
+
+    for (size_t index = 0; index < file.size(); ++index) {
+        vector<uint8_t> expected(recordBytes, static_cast<uint8_t>(1 + index));
+        EXPECT_EQ(vector<uint8_t>(file.record(index), file.record(index) + recordBytes), expected) << index;
+    }
+}
@@ -0,0 +1,54 @@
+#include "SessionIntervals.h"
+#include "gtest/gtest.h"
+#include "test_helpers.h"
+
+#include <random>
+
+using namespace std;
+
+// --- TEST CASES ---
+
+// Matches TimeUtils::isOverlap: same day, and each starts before the other ends
+TEST(SessionIntervalsTest, OverlapsLikeSessionPairs) {
+    SessionIntervals intervals;
+    ASSERT_TRUE(intervals.add(makeSession(1, "10:00", "12:00")));
+    ASSERT_TRUE(intervals.add(makeSession(3, "09:07", "10:13")));
+    EXPECT_FALSE(intervals.add(makeSession(2, "invalid", "12:00")));
+    EXPECT_EQ(intervals.size(), 2u);
+
+    EXPECT_TRUE(intervals.overlaps(1, 11 * 60, 13 * 60));
+    EXPECT_FALSE(intervals.overlaps(1, 12 * 60, 13 * 60));   // touching
+    EXPECT_FALSE(intervals.overlaps(2, 11 * 60, 12 * 60));   // the unparsed session was left out
+    EXPECT_TRUE(intervals.overlaps(3, 10 * 60 + 12, 11 * 60));
+
+    SessionIntervals other;
+    other.add(4, 0, 24 * 60);
+    EXPECT_FALSE(intervals.overlaps(other));
+    other.add(3, 8 * 60, 9 * 60 + 8);
+    EXPECT_TRUE(intervals.overlaps(other));
+    EXPECT_TRUE(other.overlaps(intervals));
+}
+
+// Blocks long enough for the vector kernels give the same answers as the scalar loop
+TEST(SessionIntervalsTest, KernelMatchesScalar) {
+    mt19937 random(42);
+    uniform_int_distribution<int> day(1, 7);
+    uniform_int_distribution<int> minute(7 * 60, 21 * 60);
+    uniform_int_distribution<int> length(1, 180);
+
+    for (int round = 0; round < 200; round++) {
+        SessionIntervals intervals;
+        int count = round % 41;
+        for (int i = 0; i < count; i++) {
+            int start = minute(random);
+            intervals.add(day(random), start, start + length(random));
+        }
+
+        for (int probe = 0; probe < 50; probe++) {
+            int probeDay = day(random);
+            int start = minute(random);
+            int end = start + length(random);
+            ASSERT_EQ(intervals.overlaps(probeDay, start, end), intervals.overlapsScalar(probeDay, start, end));
+        }
+    }
+}
@@ -61,4 +61,37 @@ TEST(TimeUtilsTest, ToMinutes_InvalidFormat) {
     EXPECT_ANY_THROW(TimeUtils::toMinutes("invalid"));     // Not a time
     EXPECT_ANY_THROW(TimeUtils::toMinutes("25:61"));       // Invalid hour/minute
     EXPECT_ANY_THROW(TimeUtils::toMinutes("10"));          // Missing minutes
-}
\ No newline at end of file
+}
+// Parsed sessions carry their minutes, and those are what comparisons use
+TEST(TimeUtilsTest, ParsedSessionsCarryMinutes) {
+    Session parsed = parseSingleSession("S,2,09:30,11:15,1401,4");
+    EXPECT_EQ(parsed.start_minutes, 570);
+    EXPECT_EQ(parsed.end_minutes, 675);
+
+    auto other = makeSession(2, "11:00", "12:00");
+    EXPECT_TRUE(TimeUtils::isOverlap(&parsed, &other));
+
+    EXPECT_EQ(TimeUtils::formatMinutes(other.end_minutes), "12:00");
+    EXPECT_EQ(TimeUtils::formatMinutes(545), "09:05");
+    EXPECT_EQ(TimeUtils::formatMinutes(-1), "");
+}
+
+// Times the stoi based parser accepted still parse to the same minutes
+TEST(TimeUtilsTest, ParseMinutesAcceptsEarlierFormats) {
+    int minutes = -1;
+    EXPECT_TRUE(TimeUtils::parseMinutes("9:5", minutes));
+    EXPECT_EQ(minutes, 545);
+    EXPECT_TRUE(TimeUtils::parseMinutes("09:30:00", minutes));
+    EXPECT_EQ(minutes, 570);
+    EXPECT_TRUE(TimeUtils::parseMinutes(" 9:30", minutes));
+    EXPECT_EQ(minutes, 570);
+    EXPECT_EQ(TimeUtils::toMinutes("14: 05"), 845);
+
+    EXPECT_FALSE(TimeUtils::parseMinutes("", minutes));
+    EXPECT_FALSE(TimeUtils::parseMinutes(":30", minutes));
+    EXPECT_FALSE(TimeUtils::parseMinutes("9:", minutes));
+    EXPECT_FALSE(TimeUtils::parseMinutes("24:00", minutes));
+    EXPECT_FALSE(TimeUtils::parseMinutes("-1:30", minutes));
+    EXPECT_FALSE(TimeUtils::parseMinutes("99999999999:00", minutes));
+    EXPECT_EQ(minutes, 570);  // left alone when the time does not parse
+}
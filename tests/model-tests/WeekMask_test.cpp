@@ -0,0 +1,85 @@
+#include "WeekMask.h"
+#include "gtest/gtest.h"
+#include "test_helpers.h"
+
+using namespace std;
+
+// --- TEST CASES ---
+
+// Overlapping sessions on the same day share at least one slot
+TEST(WeekMaskTest, OverlappingSessionsIntersect) {
+    WeekMask a, b;
+    ASSERT_TRUE(a.addSession(makeSession(1, "10:00", "12:00")));
+    ASSERT_TRUE(b.addSession(makeSession(1, "11:00", "13:00")));
+
+    EXPECT_TRUE(a.intersects(b));
+}
+
+// A session ending exactly when the other begins does not share a slot
+TEST(WeekMaskTest, TouchingSessionsDoNotIntersect) {
+    WeekMask a, b;
+    ASSERT_TRUE(a.addSession(makeSession(2, "10:00", "11:00")));
+    ASSERT_TRUE(b.addSession(makeSession(2, "11:00", "12:00")));
+
+    EXPECT_FALSE(a.intersects(b));
+}
+
+// Same hours on different days never intersect
+TEST(WeekMaskTest, DifferentDaysDoNotIntersect) {
+    WeekMask a, b;
+    ASSERT_TRUE(a.addSession(makeSession(1, "09:00", "10:00")));
+    ASSERT_TRUE(b.addSession(makeSession(7, "09:00", "10:00")));
+
+    EXPECT_FALSE(a.intersects(b));
+}
+
+// Sessions that span a 64-bit word boundary and the end of the day are fully marked
+TEST(WeekMaskTest, LongSessionsAreFullyMarked) {
+    WeekMask allDay, lateEvening, earlyMorning;
+    ASSERT_TRUE(allDay.addSession(makeSession(3, "00:00", "23:55")));
+    ASSERT_TRUE(lateEvening.addSession(makeSession(3, "23:50", "23:55")));
+    ASSERT_TRUE(earlyMorning.addSession(makeSession(3, "00:00", "00:05")));
+
+    EXPECT_TRUE(allDay.intersects(lateEvening));
+    EXPECT_TRUE(allDay.intersects(earlyMorning));
+}
+
+// Times that do not fall on slot boundaries cannot be represented exactly
+TEST(WeekMaskTest, OffGridTimesAreRejected) {
+    WeekMask mask;
+    EXPECT_FALSE(mask.addSession(makeSession(1, "10:02", "11:00")));
+    EXPECT_FALSE(mask.addSession(makeSession(0, "10:00", "11:00")));  // Day out of range
+    EXPECT_FALSE(mask.addSession(makeSession(1, "12:00", "10:00")));  // Reversed range
+    EXPECT_FALSE(mask.addSession(makeSession(1, "invalid", "10:00")));
+}
+
+// Merging keeps the slots of both masks
+TEST(WeekMaskTest, MergeCombinesSlots) {
+    WeekMask a, b, probe;
+    ASSERT_TRUE(a.addSession(makeSession(1, "08:00", "09:00")));
+    ASSERT_TRUE(b.addSession(makeSession(4, "14:00", "15:00")));
+    ASSERT_TRUE(probe.addSession(makeSession(4, "14:30", "14:45")));
+
+    EXPECT_FALSE(a.intersects(probe));
+    a.merge(b);
+    EXPECT_TRUE(a.intersects(probe));
+    EXPECT_FALSE(a.empty());
+}
+
+// A coarser grid over fewer days is smaller and only takes sessions that fit it exactly
+TEST(WeekMaskTest, CoarserGridsTakeOnlyFittingSessions) {
+    using SchoolWeek = SlotMask<15, 5>;
+    EXPECT_EQ(SchoolWeek::WORDS, 8);   // one cache line
+    EXPECT_EQ(WeekMask::WORDS, 32);
+
+    SchoolWeek a, b;
+    ASSERT_TRUE(a.addSession(makeSession(5, "10:15", "11:45")));
+    ASSERT_TRUE(b.addSession(makeSession(5, "11:30", "12:00")));
+    EXPECT_TRUE(a.intersects(b));
+
+    SchoolWeek probe;
+    EXPECT_FALSE(probe.addSession(makeSession(5, "10:05", "11:00")));  // Between two slots
+    EXPECT_FALSE(probe.addSession(makeSession(6, "10:00", "11:00")));  // Friday is outside the grid
+    ASSERT_TRUE(probe.addSession(makeSession(5, "11:45", "12:00")));
+    EXPECT_FALSE(a.intersects(probe));
+}
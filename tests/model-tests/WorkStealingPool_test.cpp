@@ -0,0 +1,59 @@
+#include "WorkStealingPool.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+
+using namespace std;
+
+// --- TEST CASES ---
+
+// Every task runs exactly once, whatever the thread count
+TEST(WorkStealingPoolTest, RunsEveryTaskOnce) {
+    for (int threads : {1, 2, 8}) {
+        WorkStealingPool pool(threads);
+        vector<atomic<int>> runs(1000);
+
+        pool.run(runs.size(), [&](size_t task) {
+            runs[task]++;
+        });
+
+        for (const auto& count : runs) {
+            ASSERT_EQ(count.load(), 1);
+        }
+    }
+}
+
+// Idle workers steal from a worker stuck on a long task
+TEST(WorkStealingPoolTest, IdleWorkersStealQueuedTasks) {
+    WorkStealingPool pool(2);
+    atomic<int> finished{0};
+    bool timedOut = false;
+
+    // Tasks 1..3 are queued behind task 0 on the same worker; task 0 holds whichever
+    // worker runs it until every other task ran, which only stealing allows
+    pool.run(8, [&](size_t task) {
+        if (task == 0) {
+            auto deadline = chrono::steady_clock::now() + chrono::seconds(5);
+            while (finished < 7) {
+                if (chrono::steady_clock::now() > deadline) {
+                    timedOut = true;
+                    break;
+                }
+                this_thread::sleep_for(chrono::milliseconds(1));
+            }
+        }
+        finished++;
+    });
+
+    EXPECT_FALSE(timedOut);
+    EXPECT_EQ(finished.load(), 8);
+}
+
+// Running an empty batch returns immediately
+TEST(WorkStealingPoolTest, EmptyBatch) {
+    WorkStealingPool pool(4);
+    bool called = false;
+    pool.run(0, [&](size_t) { called = true; });
+    EXPECT_FALSE(called);
+}
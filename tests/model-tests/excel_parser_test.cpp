@@ -167,8 +167,8 @@ TEST_F(ExcelParserTest, ParsesSingleSessionWithHebrewDay) {
     Session session = parser.parseSingleSession("א'10:00-12:00", "הנדסה-1104 - 243", "ד\"ר כהן");
 
     EXPECT_EQ(session.day_of_week, 1) << "Hebrew 'א' should map to day 1 (Sunday)";
-    EXPECT_EQ(session.start_time, "10:00");
-    EXPECT_EQ(session.end_time, "12:00");
+    EXPECT_EQ(session.start_minutes, 600);
+    EXPECT_EQ(session.end_minutes, 720);
     EXPECT_EQ(session.building_number, "הנדסה 1104");
     EXPECT_EQ(session.room_number, "243");
 }
@@ -265,15 +265,15 @@ TEST_F(ExcelParserTest, ParsesMultipleSessions) {
     if (sessions.size() >= 2) {
         // First session (Sunday)
         EXPECT_EQ(sessions[0].day_of_week, 1);
-        EXPECT_EQ(sessions[0].start_time, "10:00");
-        EXPECT_EQ(sessions[0].end_time, "12:00");
+        EXPECT_EQ(sessions[0].start_minutes, 600);
+        EXPECT_EQ(sessions[0].end_minutes, 720);
         EXPECT_EQ(sessions[0].building_number, "הנדסה 1104");
         EXPECT_EQ(sessions[0].room_number, "243");
 
         // Second session (Tuesday)
         EXPECT_EQ(sessions[1].day_of_week, 3);
-        EXPECT_EQ(sessions[1].start_time, "14:00");
-        EXPECT_EQ(sessions[1].end_time, "16:00");
+        EXPECT_EQ(sessions[1].start_minutes, 840);
+        EXPECT_EQ(sessions[1].end_minutes, 960);
         EXPECT_EQ(sessions[1].building_number, "וואהל 1401");
         EXPECT_EQ(sessions[1].room_number, "4");
     }
@@ -307,7 +307,7 @@ TEST_F(ExcelParserTest, HandlesInvalidTimeFormats) {
     // Empty time slot
     Session session2 = parser.parseSingleSession("", "", "");
     EXPECT_EQ(session2.day_of_week, 0);
-    EXPECT_TRUE(session2.start_time.empty());
+    EXPECT_EQ(session2.start_minutes, -1);
 
     // Time without Hebrew day apostrophe
     Session session3 = parser.parseSingleSession("10:00-12:00", "", "");
@@ -331,6 +331,6 @@ TEST_F(ExcelParserTest, HandlesSessionParsingEdgeCases) {
     // Test sessions with valid Hebrew day format but invalid times
     Session validFormatInvalidTime = parser.parseSingleSession("א'25:00-26:00", "", "");
     EXPECT_EQ(validFormatInvalidTime.day_of_week, 1); // Day should be parsed correctly
-    EXPECT_EQ(validFormatInvalidTime.start_time, "25:00"); // Time is not validated by parser
-    EXPECT_EQ(validFormatInvalidTime.end_time, "26:00");
+    EXPECT_EQ(validFormatInvalidTime.start_minutes, -1); // Times out of range are rejected while parsing
+    EXPECT_EQ(validFormatInvalidTime.end_minutes, -1);
 }
\ No newline at end of file
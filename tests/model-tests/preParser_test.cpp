@@ -102,12 +102,12 @@ TEST(PreParserTest, InvalidUserInput_InvalidID) {
     ASSERT_EQ(input.size(), 4) << "Expected no valid course IDs, but got some.";
 }
 
-// Test: invalid user input too many courses
-TEST(PreParserTest, RejectsMoreThanSevenTotalCourses) {
-    string testPath = "../testData/txt/userInput_TooManyTotal.txt";
+// Test: selections are no longer capped, generation budgets bound large ones instead
+TEST(PreParserTest, AcceptsMoreThanSevenCourses) {
+    string testPath = "../testData/txt/invalidUserInput_many.txt";
     unordered_set<string> input = readSelectedCourseIDs(testPath);
 
-    EXPECT_TRUE(input.empty()) << "Expected input to be rejected due to more than 7 valid course IDs.";
+    EXPECT_EQ(input.size(), 8) << "Expected every valid course ID to be kept.";
 }
 
 // Test: invalid user input: no input
@@ -172,8 +172,8 @@ TEST(PreParserTest, VerifyNewCourseStructure) {
             const Session& session = course.Lectures[0].sessions[0];
             EXPECT_GE(session.day_of_week, 0);
             EXPECT_LE(session.day_of_week, 6);
-            EXPECT_FALSE(session.start_time.empty());
-            EXPECT_FALSE(session.end_time.empty());
+            EXPECT_GE(session.start_minutes, 0);
+            EXPECT_GT(session.end_minutes, session.start_minutes);
             // building_number and room_number might be empty, so we don't test them
         }
     }
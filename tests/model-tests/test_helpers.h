@@ -2,9 +2,15 @@
 #define TEST_HELPERS_H
 
 #include "model_interfaces.h"
+#include "schedule_algorithm/TimeUtils.h"
 
+// Times that do not parse are left at -1, like a session read with a broken time
 inline Session makeSession(int day, const std::string& start, const std::string& end) {
-    return Session{.day_of_week = day, .start_time = start, .end_time = end};
+    Session session;
+    session.day_of_week = day;
+    TimeUtils::parseMinutes(start, session.start_minutes);
+    TimeUtils::parseMinutes(end, session.end_minutes);
+    return session;
 }
 
 #endif // TEST_HELPERS_H
@@ -79,6 +79,15 @@ Page {
         }
     }
 
+    FilterMenu {
+        id: filterPopup
+        parent: Overlay.overlay
+
+        onFiltersApplied: function(filterData) {
+            courseSelectionController.setScheduleFilters(filterData);
+        }
+    }
+
     AddCoursePopup {
         id: addCoursePopup
         parent: Overlay.overlay
@@ -257,6 +266,41 @@ Page {
                     }
                 }
 
+                // filter button, the filters limit which schedules are generated
+                Button {
+                    id: filterButton
+                    width: 100
+                    height: 40
+                    anchors {
+                        right: generateButton.left
+                        rightMargin: 10
+                        verticalCenter: parent.verticalCenter
+                    }
+                    visible: selectedCoursesRepeater.count > 0
+
+                    background: Rectangle {
+                        color: filterMouseArea.containsMouse ? "#e5e7eb" : "#f3f4f6"
+                        border.color: filterPopup.anyEnabled ? "#10b981" : "#d1d5db"
+                        border.width: 1
+                        radius: 4
+                    }
+                    contentItem: Text {
+                        text: filterPopup.anyEnabled ? "Filters ✓" : "Filters"
+                        color: "#1f2937"
+                        font.pixelSize: 14
+                        horizontalAlignment: Text.AlignHCenter
+                        verticalAlignment: Text.AlignVCenter
+                    }
+
+                    MouseArea {
+                        id: filterMouseArea
+                        anchors.fill: parent
+                        hoverEnabled: true
+                        cursorShape: Qt.PointingHandCursor
+                        onClicked: filterPopup.open()
+                    }
+                }
+
                 // generate button
                 Button {
                     id: generateButton
@@ -806,8 +850,6 @@ Page {
                             color: {
                                 if (isCourseSelectedSafe(originalIndex)) {
                                     return "#f0f9ff"
-                                } else if (selectedCoursesRepeater.count >= 7) {
-                                    return "#e5e7eb"
                                 } else {
                                     return "#ffffff"
                                 }
@@ -816,13 +858,10 @@ Page {
                             border.color: {
                                 if (isCourseSelectedSafe(originalIndex)) {
                                     return "#3b82f6"
-                                } else if (selectedCoursesRepeater.count >= 7) {
-                                    return "#d1d5db"
                                 } else {
                                     return "#e5e7eb"
                                 }
                             }
-                            opacity: selectedCoursesRepeater.count >= 7 && !courseSelectionController.isCourseSelected(originalIndex) ? 0.7 : 1
 
                             Connections {
                                 target: courseSelectionController
@@ -833,12 +872,6 @@ Page {
                                         courseDelegate.opacity = 1
                                         courseIdBox.color = "#dbeafe"
                                         courseIdBoxLabel.color = "#2563eb"
-                                    } else if (selectedCoursesRepeater.count >= 7) {
-                                        courseDelegate.color = "#e5e7eb"
-                                        courseDelegate.border.color = "#d1d5db"
-                                        courseDelegate.opacity = 0.7
-                                        courseIdBox.color = "#e5e7eb"
-                                        courseIdBoxLabel.color = "#9ca3af"
                                     } else {
                                         courseDelegate.color = "#ffffff"
                                         courseDelegate.border.color = "#e5e7eb"
@@ -867,8 +900,6 @@ Page {
                                     color: {
                                         if (isCourseSelectedSafe(originalIndex)) {
                                             return "#dbeafe"
-                                        } else if (selectedCoursesRepeater.count >= 7) {
-                                            return "#e5e7eb"
                                         } else {
                                             return "#f3f4f6"
                                         }
@@ -883,8 +914,6 @@ Page {
                                         color: {
                                             if (isCourseSelectedSafe(originalIndex)) {
                                                 return "#2563eb"
-                                            } else if (selectedCoursesRepeater.count >= 7) {
-                                                return "#9ca3af"
                                             } else {
                                                 return "#4b5563"
                                             }
@@ -914,13 +943,7 @@ Page {
                                         text: courseName
                                         font.pixelSize: 16
                                         font.bold: true
-                                        color: {
-                                            if (selectedCoursesRepeater.count >= 7 && !courseSelectionController.isCourseSelected(originalIndex)) {
-                                                return "#9ca3af"
-                                            } else {
-                                                return "#1f2937"
-                                            }
-                                        }
+                                        color: "#1f2937"
                                         elide: Text.ElideRight
                                     }
 
@@ -935,13 +958,7 @@ Page {
                                         height: 18
                                         text: "Instructor: " + teacherName
                                         font.pixelSize: 14
-                                        color: {
-                                            if (selectedCoursesRepeater.count >= 7 && !courseSelectionController.isCourseSelected(originalIndex)) {
-                                                return "#9ca3af"
-                                            } else {
-                                                return "#6b7280"
-                                            }
-                                        }
+                                        color: "#6b7280"
                                         elide: Text.ElideRight
                                     }
                                 }
@@ -954,12 +971,7 @@ Page {
                                         return;
                                     }
 
-                                    if (selectedCoursesRepeater.count >= 7 && !isCourseSelectedSafe(originalIndex)) {
-                                        errorMessage = "You have selected the maximum of 7 courses"
-                                        errorMessageTimer.restart()
-                                    } else {
-                                        courseSelectionController.toggleCourseSelection(originalIndex)
-                                    }
+                                    courseSelectionController.toggleCourseSelection(originalIndex)
                                 }
                             }
                         }
@@ -1090,7 +1102,7 @@ Page {
 
                                 Label {
                                     anchors.centerIn: parent
-                                    text: selectedCoursesRepeater.count + "/7"
+                                    text: selectedCoursesRepeater.count
                                     font.pixelSize: 14
                                     font.bold: true
                                     color: "#1f2937"
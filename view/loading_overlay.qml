@@ -245,7 +245,10 @@ Rectangle {
 
         Text {
             id: loadingText
-            text: "Generating schedules"
+            property var expectedCount: courseSelectionController ? courseSelectionController.expectedScheduleCount : -1
+            text: expectedCount >= 0
+                  ? "Generating " + expectedCount.toLocaleString(Qt.locale(), 'f', 0) + " schedules"
+                  : "Generating schedules"
             anchors.horizontalCenter: parent.horizontalCenter
             color: "#e2e8f0"
             font.pixelSize: Math.max(16, root.height * 0.024)
@@ -285,6 +288,40 @@ Rectangle {
             }
         }
 
+        // Explored share of the search, shown once the generation reported it
+        Column {
+            anchors.horizontalCenter: parent.horizontalCenter
+            spacing: root.height * 0.008
+            visible: progressBar.progress >= 0
+
+            Rectangle {
+                id: progressBar
+                property real progress: courseSelectionController ? courseSelectionController.generationProgress : -1
+                width: Math.max(200, root.width * 0.3)
+                height: Math.max(6, root.height * 0.008)
+                radius: height / 2
+                color: "#4a5568"
+
+                Rectangle {
+                    width: parent.width * Math.max(0, Math.min(1, progressBar.progress))
+                    height: parent.height
+                    radius: parent.radius
+                    color: "#60a5fa"
+
+                    Behavior on width {
+                        NumberAnimation { duration: 200 }
+                    }
+                }
+            }
+
+            Text {
+                anchors.horizontalCenter: parent.horizontalCenter
+                text: Math.floor(Math.max(0, progressBar.progress) * 100) + "%"
+                color: "#e2e8f0"
+                font.pixelSize: Math.max(12, root.height * 0.016)
+            }
+        }
+
         // Status text
         Text {
             id: statusText
@@ -321,5 +358,35 @@ Rectangle {
                 }
             }
         }
+
+        Button {
+            id: abortButton
+            anchors.horizontalCenter: parent.horizontalCenter
+            width: 120
+            height: 36
+
+            background: Rectangle {
+                color: abortMouseArea.containsMouse ? "#4a5568" : "#2d3748"
+                border.color: "#718096"
+                border.width: 1
+                radius: 4
+            }
+
+            contentItem: Text {
+                text: "Cancel"
+                font.pixelSize: 14
+                color: "#e2e8f0"
+                horizontalAlignment: Text.AlignHCenter
+                verticalAlignment: Text.AlignVCenter
+            }
+
+            MouseArea {
+                id: abortMouseArea
+                anchors.fill: parent
+                hoverEnabled: true
+                cursorShape: Qt.PointingHandCursor
+                onClicked: root.abortRequested()
+            }
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,300 @@
+import QtQuick 2.15
+import QtQuick.Layouts 1.15
+import QtQuick.Controls 2.15
+import QtQuick.Controls.Basic
+
+Popup {
+    id: root
+
+    signal filtersApplied(var filterData)
+
+    // Filter properties, times are minutes from midnight
+    property bool daysToStudyEnabled: false
+    property int daysToStudyValue: 7
+    property bool totalGapsEnabled: false
+    property int totalGapsValue: 0
+    property bool maxGapsTimeEnabled: false
+    property int maxGapsTimeValue: 90
+    property bool avgDayStartEnabled: false
+    property int avgDayStartValue: 8 * 60
+    property bool avgDayEndEnabled: false
+    property int avgDayEndValue: 17 * 60
+    property bool earliestStartEnabled: false
+    property int earliestStartValue: 8 * 60
+
+    readonly property bool anyEnabled: daysToStudyEnabled || totalGapsEnabled || maxGapsTimeEnabled ||
+                                       avgDayStartEnabled || avgDayEndEnabled || earliestStartEnabled
+
+    width: 420
+    height: 620
+    modal: true
+    focus: true
+    clip: true
+    closePolicy: Popup.CloseOnEscape | Popup.CloseOnPressOutsideParent
+
+    background: Rectangle {
+        color: "#1f2937"
+        border.color: "#d1d5db"
+        border.width: 1
+        radius: 6
+    }
+
+    x: (parent.width - width) / 2
+    y: (parent.height - height) / 2
+
+    function formatMinutes(minutes) {
+        return String(Math.floor(minutes / 60)).padStart(2, '0') + ":" + String(minutes % 60).padStart(2, '0');
+    }
+
+    // Same layout as ScheduleFilter::criteriaFromMap reads
+    function getCurrentFilterData() {
+        return {
+            daysToStudy: {
+                enabled: root.daysToStudyEnabled,
+                value: root.daysToStudyValue
+            },
+            totalGaps: {
+                enabled: root.totalGapsEnabled,
+                value: root.totalGapsValue
+            },
+            maxGapsTime: {
+                enabled: root.maxGapsTimeEnabled,
+                value: root.maxGapsTimeValue
+            },
+            avgDayStart: {
+                enabled: root.avgDayStartEnabled,
+                hour: Math.floor(root.avgDayStartValue / 60),
+                minute: root.avgDayStartValue % 60
+            },
+            avgDayEnd: {
+                enabled: root.avgDayEndEnabled,
+                hour: Math.floor(root.avgDayEndValue / 60),
+                minute: root.avgDayEndValue % 60
+            },
+            earliestStart: {
+                enabled: root.earliestStartEnabled,
+                hour: Math.floor(root.earliestStartValue / 60),
+                minute: root.earliestStartValue % 60
+            }
+        }
+    }
+
+    // One filter: a toggle, its name and the limit it sets
+    component FilterRow: Item {
+        id: filterRow
+        property string label: ""
+        property bool filterEnabled: false
+        property bool isTime: false
+        property alias from: spinBox.from
+        property alias to: spinBox.to
+        property alias stepSize: spinBox.stepSize
+        property alias value: spinBox.value
+        signal toggled()
+
+        width: parent.width
+        height: 50
+
+        Rectangle {
+            id: toggle
+            width: 60
+            height: 30
+            anchors.left: parent.left
+            anchors.verticalCenter: parent.verticalCenter
+            color: filterRow.filterEnabled ? "#10b981" : "#374151"
+            radius: 15
+            border.width: 2
+            border.color: filterRow.filterEnabled ? "#059669" : "#4b5563"
+
+            Rectangle {
+                width: 22
+                height: 22
+                radius: 11
+                color: "#ffffff"
+                x: filterRow.filterEnabled ? parent.width - width - 4 : 4
+                anchors.verticalCenter: parent.verticalCenter
+
+                Behavior on x {
+                    NumberAnimation {
+                        duration: 200
+                    }
+                }
+            }
+
+            MouseArea {
+                anchors.fill: parent
+                cursorShape: Qt.PointingHandCursor
+                onClicked: filterRow.toggled()
+            }
+        }
+
+        Text {
+            text: filterRow.label
+            font.pixelSize: 16
+            color: "#ffffff"
+            anchors.left: toggle.right
+            anchors.leftMargin: 15
+            anchors.verticalCenter: parent.verticalCenter
+        }
+
+        SpinBox {
+            id: spinBox
+            width: 130
+            height: 40
+            editable: false
+            enabled: filterRow.filterEnabled
+            opacity: filterRow.filterEnabled ? 1.0 : 0.4
+            anchors.right: parent.right
+            anchors.verticalCenter: parent.verticalCenter
+
+            textFromValue: function(value) {
+                return filterRow.isTime ? root.formatMinutes(value) : String(value)
+            }
+
+            background: Rectangle {
+                color: "#374151"
+                radius: 4
+                border.width: 1
+                border.color: "#4b5563"
+            }
+
+            contentItem: Text {
+                text: spinBox.textFromValue(spinBox.value, spinBox.locale)
+                font.pixelSize: 14
+                color: "#ffffff"
+                horizontalAlignment: Text.AlignHCenter
+                verticalAlignment: Text.AlignVCenter
+            }
+        }
+    }
+
+    Column {
+        width: parent.width
+        height: parent.height
+        spacing: 20
+
+        // Header
+        Rectangle {
+            width: parent.width
+            height: 60
+            color: "transparent"
+
+            Item {
+                anchors.fill: parent
+                anchors.margins: 10
+
+                Text {
+                    text: "Filter Schedules"
+                    font.pixelSize: 20
+                    font.bold: true
+                    color: "#ffffff"
+                    anchors.verticalCenter: parent.verticalCenter
+                    anchors.left: parent.left
+                }
+            }
+        }
+
+        FilterRow {
+            label: "Max Days to Study"
+            filterEnabled: root.daysToStudyEnabled
+            from: 1
+            to: 7
+            stepSize: 1
+            value: root.daysToStudyValue
+            onToggled: root.daysToStudyEnabled = !root.daysToStudyEnabled
+            onValueChanged: root.daysToStudyValue = value
+        }
+
+        FilterRow {
+            label: "Max Gaps"
+            filterEnabled: root.totalGapsEnabled
+            from: 0
+            to: 20
+            stepSize: 1
+            value: root.totalGapsValue
+            onToggled: root.totalGapsEnabled = !root.totalGapsEnabled
+            onValueChanged: root.totalGapsValue = value
+        }
+
+        FilterRow {
+            label: "Max Gap Minutes"
+            filterEnabled: root.maxGapsTimeEnabled
+            from: 30
+            to: 600
+            stepSize: 30
+            value: root.maxGapsTimeValue
+            onToggled: root.maxGapsTimeEnabled = !root.maxGapsTimeEnabled
+            onValueChanged: root.maxGapsTimeValue = value
+        }
+
+        FilterRow {
+            label: "Earliest Start"
+            isTime: true
+            filterEnabled: root.earliestStartEnabled
+            from: 6 * 60
+            to: 22 * 60
+            stepSize: 30
+            value: root.earliestStartValue
+            onToggled: root.earliestStartEnabled = !root.earliestStartEnabled
+            onValueChanged: root.earliestStartValue = value
+        }
+
+        FilterRow {
+            label: "Avg Day Start After"
+            isTime: true
+            filterEnabled: root.avgDayStartEnabled
+            from: 6 * 60
+            to: 22 * 60
+            stepSize: 30
+            value: root.avgDayStartValue
+            onToggled: root.avgDayStartEnabled = !root.avgDayStartEnabled
+            onValueChanged: root.avgDayStartValue = value
+        }
+
+        FilterRow {
+            label: "Avg Day End Before"
+            isTime: true
+            filterEnabled: root.avgDayEndEnabled
+            from: 6 * 60
+            to: 23 * 60
+            stepSize: 30
+            value: root.avgDayEndValue
+            onToggled: root.avgDayEndEnabled = !root.avgDayEndEnabled
+            onValueChanged: root.avgDayEndValue = value
+        }
+
+        // Apply filters button
+        Item {
+            width: parent.width
+            height: 60
+
+            Rectangle {
+                width: parent.width
+                height: 50
+                anchors.centerIn: parent
+                color: applyMouseArea.containsMouse ? "#656363" : "#918a8a"
+                radius: 6
+                border.color: "#656363"
+                border.width: 1
+
+                Text {
+                    text: "Apply filters"
+                    font.pixelSize: 16
+                    font.bold: true
+                    color: "#ffffff"
+                    anchors.centerIn: parent
+                }
+
+                MouseArea {
+                    id: applyMouseArea
+                    anchors.fill: parent
+                    hoverEnabled: true
+                    cursorShape: Qt.PointingHandCursor
+                    onClicked: {
+                        root.filtersApplied(getCurrentFilterData())
+                        root.close()
+                    }
+                }
+            }
+        }
+    }
+}
@@ -8,20 +8,25 @@ Popup {
 
     signal sortingApplied(var sortData)
 
-    // Sort properties
+    // Sort properties, every enabled field adds its metric times its weight to the ranking
     property bool daysToStudyEnabled: false
     property bool daysToStudyAscending: true
+    property real daysToStudyWeight: 1.0
     property bool totalGapsEnabled: false
     property bool totalGapsAscending: true
+    property real totalGapsWeight: 1.0
     property bool maxGapsTimeEnabled: false
     property bool maxGapsTimeAscending: true
+    property real maxGapsTimeWeight: 1.0
     property bool avgDayStartEnabled: false
     property bool avgDayStartAscending: true
+    property real avgDayStartWeight: 1.0
     property bool avgDayEndEnabled: false
     property bool avgDayEndAscending: true
+    property real avgDayEndWeight: 1.0
 
     width: 400
-    height: 600
+    height: 720
     modal: true
     focus: true
     clip: true
@@ -37,45 +42,97 @@ Popup {
     x: (parent.width - width) / 2
     y: (parent.height - height) / 2
 
-    // make the selection unique
-    function disableAllSortsExcept(keepEnabled) {
-        if (keepEnabled !== "daysToStudy") daysToStudyEnabled = false
-        if (keepEnabled !== "totalGaps") totalGapsEnabled = false
-        if (keepEnabled !== "maxGapsTime") maxGapsTimeEnabled = false
-        if (keepEnabled !== "avgDayStart") avgDayStartEnabled = false
-        if (keepEnabled !== "avgDayEnd") avgDayEndEnabled = false
+    // Re-ranks right away, used while the menu stays open
+    function rerank() {
+        root.sortingApplied(getCurrentSortData())
     }
 
     function getCurrentSortData() {
         return {
             amount_days: {
                 enabled: root.daysToStudyEnabled,
-                ascending: root.daysToStudyAscending
+                ascending: root.daysToStudyAscending,
+                weight: root.daysToStudyWeight
             },
             amount_gaps: {
                 enabled: root.totalGapsEnabled,
-                ascending: root.totalGapsAscending
+                ascending: root.totalGapsAscending,
+                weight: root.totalGapsWeight
             },
             gaps_time: {
                 enabled: root.maxGapsTimeEnabled,
-                ascending: root.maxGapsTimeAscending
+                ascending: root.maxGapsTimeAscending,
+                weight: root.maxGapsTimeWeight
             },
             avg_start: {
                 enabled: root.avgDayStartEnabled,
-                ascending: root.avgDayStartAscending
+                ascending: root.avgDayStartAscending,
+                weight: root.avgDayStartWeight
             },
             avg_end: {
                 enabled: root.avgDayEndEnabled,
-                ascending: root.avgDayEndAscending
+                ascending: root.avgDayEndAscending,
+                weight: root.avgDayEndWeight
             }
         }
     }
 
 
+    // Weight of one field, the ranking is redone when the handle is released
+    component WeightSlider: Item {
+        id: weightSlider
+        property bool fieldEnabled: false
+        property alias value: slider.value
+        signal weightReleased()
+
+        height: 30
+        opacity: fieldEnabled ? 1.0 : 0.4
+
+        Text {
+            id: weightLabel
+            text: "Weight"
+            font.pixelSize: 14
+            color: "#d1d5db"
+            anchors.left: parent.left
+            anchors.leftMargin: 75
+            anchors.verticalCenter: parent.verticalCenter
+        }
+
+        Slider {
+            id: slider
+            from: 0.1
+            to: 5.0
+            stepSize: 0.1
+            value: 1.0
+            enabled: weightSlider.fieldEnabled
+            anchors.left: weightLabel.right
+            anchors.leftMargin: 10
+            anchors.right: weightValue.left
+            anchors.rightMargin: 10
+            anchors.verticalCenter: parent.verticalCenter
+            onPressedChanged: {
+                if (!pressed) {
+                    weightSlider.weightReleased()
+                }
+            }
+        }
+
+        Text {
+            id: weightValue
+            text: slider.value.toFixed(1)
+            width: 30
+            font.pixelSize: 14
+            color: "#ffffff"
+            horizontalAlignment: Text.AlignRight
+            anchors.right: parent.right
+            anchors.verticalCenter: parent.verticalCenter
+        }
+    }
+
     Column {
         width: parent.width
         height: parent.height
-        spacing: 30
+        spacing: 20
 
         // Header
         Rectangle {
@@ -99,639 +156,674 @@ Popup {
         }
 
         // Days to Study sort
-        Item {
+        Column {
             width: parent.width
-            height: 50
+            spacing: 4
 
-            // Toggle Button
-            Rectangle {
-                id: daysToggle
-                width: 60
-                height: 30
-                anchors.left: parent.left
-                anchors.verticalCenter: parent.verticalCenter
-                color: daysToStudyEnabled ? "#10b981" : "#374151"
-                radius: 15
-                border.width: 2
-                border.color: daysToStudyEnabled ? "#059669" : "#4b5563"
+            Item {
+                width: parent.width
+                height: 50
 
+                // Toggle Button
                 Rectangle {
-                    width: 22
-                    height: 22
-                    radius: 11
-                    color: "#ffffff"
-                    x: daysToStudyEnabled ? parent.width - width - 4 : 4
+                    id: daysToggle
+                    width: 60
+                    height: 30
+                    anchors.left: parent.left
                     anchors.verticalCenter: parent.verticalCenter
+                    color: daysToStudyEnabled ? "#10b981" : "#374151"
+                    radius: 15
+                    border.width: 2
+                    border.color: daysToStudyEnabled ? "#059669" : "#4b5563"
 
-                    Behavior on x {
-                        NumberAnimation {
-                            duration: 200
+                    Rectangle {
+                        width: 22
+                        height: 22
+                        radius: 11
+                        color: "#ffffff"
+                        x: daysToStudyEnabled ? parent.width - width - 4 : 4
+                        anchors.verticalCenter: parent.verticalCenter
+
+                        Behavior on x {
+                            NumberAnimation {
+                                duration: 200
+                            }
                         }
                     }
-                }
 
-                MouseArea {
-                    anchors.fill: parent
-                    cursorShape: Qt.PointingHandCursor
-                    onClicked: {
-                        if (!daysToStudyEnabled) {
-                            disableAllSortsExcept("daysToStudy")
-                            daysToStudyEnabled = true
-                        } else {
-                            daysToStudyEnabled = false
+                    MouseArea {
+                        anchors.fill: parent
+                        cursorShape: Qt.PointingHandCursor
+                        onClicked: {
+                            daysToStudyEnabled = !daysToStudyEnabled
                         }
                     }
                 }
-            }
-
-            Text {
-                text: "Days to Study"
-                font.pixelSize: 16
-                color: "#ffffff"
-                anchors.left: daysToggle.right
-                anchors.leftMargin: 15
-                anchors.verticalCenter: parent.verticalCenter
-            }
 
-            // Ascending/Descending Toggle
-            Rectangle {
-                width: 120
-                height: 40
-                anchors.right: parent.right
-                anchors.verticalCenter: parent.verticalCenter
-                color: "#374151"
-                radius: 4
-                border.width: 1
-                border.color: "#4b5563"
-
-                Row {
-                    anchors.centerIn: parent
-                    spacing: 0
+                Text {
+                    text: "Days to Study"
+                    font.pixelSize: 16
+                    color: "#ffffff"
+                    anchors.left: daysToggle.right
+                    anchors.leftMargin: 15
+                    anchors.verticalCenter: parent.verticalCenter
+                }
 
-                    Rectangle {
-                        width: 60
-                        height: 38
-                        color: daysToStudyEnabled && daysToStudyAscending ? "#10b981" : "#4b5563"
-                        radius: 4
-                        border.width: 1
-                        border.color: "#374151"
-
-                        Text {
-                            text: "↑"
-                            font.pixelSize: 18
-                            font.bold: true
-                            color: "#ffffff"
-                            anchors.centerIn: parent
-                        }
+                // Ascending/Descending Toggle
+                Rectangle {
+                    width: 120
+                    height: 40
+                    anchors.right: parent.right
+                    anchors.verticalCenter: parent.verticalCenter
+                    color: "#374151"
+                    radius: 4
+                    border.width: 1
+                    border.color: "#4b5563"
+
+                    Row {
+                        anchors.centerIn: parent
+                        spacing: 0
+
+                        Rectangle {
+                            width: 60
+                            height: 38
+                            color: daysToStudyEnabled && daysToStudyAscending ? "#10b981" : "#4b5563"
+                            radius: 4
+                            border.width: 1
+                            border.color: "#374151"
+
+                            Text {
+                                text: "↑"
+                                font.pixelSize: 18
+                                font.bold: true
+                                color: "#ffffff"
+                                anchors.centerIn: parent
+                            }
 
-                        MouseArea {
-                            anchors.fill: parent
-                            cursorShape: Qt.PointingHandCursor
-                            enabled: daysToStudyEnabled
-                            onClicked: {
-                                daysToStudyAscending = true
+                            MouseArea {
+                                anchors.fill: parent
+                                cursorShape: Qt.PointingHandCursor
+                                enabled: daysToStudyEnabled
+                                onClicked: {
+                                    daysToStudyAscending = true
+                                }
                             }
                         }
-                    }
 
-                    Rectangle {
-                        width: 60
-                        height: 38
-                        color: daysToStudyEnabled && !daysToStudyAscending ? "#10b981" : "#4b5563"
-                        radius: 4
-                        border.width: 1
-                        border.color: "#374151"
-
-                        Text {
-                            text: "↓"
-                            font.pixelSize: 18
-                            font.bold: true
-                            color: "#ffffff"
-                            anchors.centerIn: parent
-                        }
+                        Rectangle {
+                            width: 60
+                            height: 38
+                            color: daysToStudyEnabled && !daysToStudyAscending ? "#10b981" : "#4b5563"
+                            radius: 4
+                            border.width: 1
+                            border.color: "#374151"
+
+                            Text {
+                                text: "↓"
+                                font.pixelSize: 18
+                                font.bold: true
+                                color: "#ffffff"
+                                anchors.centerIn: parent
+                            }
 
-                        MouseArea {
-                            anchors.fill: parent
-                            cursorShape: Qt.PointingHandCursor
-                            enabled: daysToStudyEnabled
-                            onClicked: {
-                                daysToStudyAscending = false
+                            MouseArea {
+                                anchors.fill: parent
+                                cursorShape: Qt.PointingHandCursor
+                                enabled: daysToStudyEnabled
+                                onClicked: {
+                                    daysToStudyAscending = false
+                                }
                             }
                         }
                     }
                 }
             }
+
+            WeightSlider {
+                width: parent.width
+                fieldEnabled: root.daysToStudyEnabled
+                onValueChanged: root.daysToStudyWeight = value
+                onWeightReleased: root.rerank()
+            }
         }
 
         // Total Gaps sort
-        Item {
+        Column {
             width: parent.width
-            height: 50
+            spacing: 4
 
-            // Toggle Button
-            Rectangle {
-                id: gapsToggle
-                width: 60
-                height: 30
-                anchors.left: parent.left
-                anchors.verticalCenter: parent.verticalCenter
-                color: totalGapsEnabled ? "#10b981" : "#374151"
-                radius: 15
-                border.width: 2
-                border.color: totalGapsEnabled ? "#059669" : "#4b5563"
+            Item {
+                width: parent.width
+                height: 50
 
+                // Toggle Button
                 Rectangle {
-                    width: 22
-                    height: 22
-                    radius: 11
-                    color: "#ffffff"
-                    x: totalGapsEnabled ? parent.width - width - 4 : 4
+                    id: gapsToggle
+                    width: 60
+                    height: 30
+                    anchors.left: parent.left
                     anchors.verticalCenter: parent.verticalCenter
+                    color: totalGapsEnabled ? "#10b981" : "#374151"
+                    radius: 15
+                    border.width: 2
+                    border.color: totalGapsEnabled ? "#059669" : "#4b5563"
 
-                    Behavior on x {
-                        NumberAnimation {
-                            duration: 200
+                    Rectangle {
+                        width: 22
+                        height: 22
+                        radius: 11
+                        color: "#ffffff"
+                        x: totalGapsEnabled ? parent.width - width - 4 : 4
+                        anchors.verticalCenter: parent.verticalCenter
+
+                        Behavior on x {
+                            NumberAnimation {
+                                duration: 200
+                            }
                         }
                     }
-                }
 
-                MouseArea {
-                    anchors.fill: parent
-                    cursorShape: Qt.PointingHandCursor
-                    onClicked: {
-                        if (!totalGapsEnabled) {
-                            disableAllSortsExcept("totalGaps")
-                            totalGapsEnabled = true
-                        } else {
-                            totalGapsEnabled = false
+                    MouseArea {
+                        anchors.fill: parent
+                        cursorShape: Qt.PointingHandCursor
+                        onClicked: {
+                            totalGapsEnabled = !totalGapsEnabled
                         }
                     }
                 }
-            }
-
-            Text {
-                text: "Total Gaps"
-                font.pixelSize: 16
-                color: "#ffffff"
-                anchors.left: gapsToggle.right
-                anchors.leftMargin: 15
-                anchors.verticalCenter: parent.verticalCenter
-            }
 
-            // Ascending/Descending Toggle
-            Rectangle {
-                width: 120
-                height: 40
-                anchors.right: parent.right
-                anchors.verticalCenter: parent.verticalCenter
-                color: "#374151"
-                radius: 4
-                border.width: 1
-                border.color: "#4b5563"
-
-                Row {
-                    anchors.centerIn: parent
-                    spacing: 0
+                Text {
+                    text: "Total Gaps"
+                    font.pixelSize: 16
+                    color: "#ffffff"
+                    anchors.left: gapsToggle.right
+                    anchors.leftMargin: 15
+                    anchors.verticalCenter: parent.verticalCenter
+                }
 
-                    Rectangle {
-                        width: 60
-                        height: 38
-                        color: totalGapsEnabled && totalGapsAscending ? "#10b981" : "#4b5563"
-                        radius: 4
-                        border.width: 1
-                        border.color: "#374151"
-
-                        Text {
-                            text: "↑"
-                            font.pixelSize: 18
-                            font.bold: true
-                            color: "#ffffff"
-                            anchors.centerIn: parent
-                        }
+                // Ascending/Descending Toggle
+                Rectangle {
+                    width: 120
+                    height: 40
+                    anchors.right: parent.right
+                    anchors.verticalCenter: parent.verticalCenter
+                    color: "#374151"
+                    radius: 4
+                    border.width: 1
+                    border.color: "#4b5563"
+
+                    Row {
+                        anchors.centerIn: parent
+                        spacing: 0
+
+                        Rectangle {
+                            width: 60
+                            height: 38
+                            color: totalGapsEnabled && totalGapsAscending ? "#10b981" : "#4b5563"
+                            radius: 4
+                            border.width: 1
+                            border.color: "#374151"
+
+                            Text {
+                                text: "↑"
+                                font.pixelSize: 18
+                                font.bold: true
+                                color: "#ffffff"
+                                anchors.centerIn: parent
+                            }
 
-                        MouseArea {
-                            anchors.fill: parent
-                            cursorShape: Qt.PointingHandCursor
-                            enabled: totalGapsEnabled
-                            onClicked: {
-                                totalGapsAscending = true
+                            MouseArea {
+                                anchors.fill: parent
+                                cursorShape: Qt.PointingHandCursor
+                                enabled: totalGapsEnabled
+                                onClicked: {
+                                    totalGapsAscending = true
+                                }
                             }
                         }
-                    }
 
-                    Rectangle {
-                        width: 60
-                        height: 38
-                        color: totalGapsEnabled && !totalGapsAscending ? "#10b981" : "#4b5563"
-                        radius: 4
-                        border.width: 1
-                        border.color: "#374151"
-
-                        Text {
-                            text: "↓"
-                            font.pixelSize: 18
-                            font.bold: true
-                            color: "#ffffff"
-                            anchors.centerIn: parent
-                        }
+                        Rectangle {
+                            width: 60
+                            height: 38
+                            color: totalGapsEnabled && !totalGapsAscending ? "#10b981" : "#4b5563"
+                            radius: 4
+                            border.width: 1
+                            border.color: "#374151"
+
+                            Text {
+                                text: "↓"
+                                font.pixelSize: 18
+                                font.bold: true
+                                color: "#ffffff"
+                                anchors.centerIn: parent
+                            }
 
-                        MouseArea {
-                            anchors.fill: parent
-                            cursorShape: Qt.PointingHandCursor
-                            enabled: totalGapsEnabled
-                            onClicked: {
-                                totalGapsAscending = false
+                            MouseArea {
+                                anchors.fill: parent
+                                cursorShape: Qt.PointingHandCursor
+                                enabled: totalGapsEnabled
+                                onClicked: {
+                                    totalGapsAscending = false
+                                }
                             }
                         }
                     }
                 }
             }
+
+            WeightSlider {
+                width: parent.width
+                fieldEnabled: root.totalGapsEnabled
+                onValueChanged: root.totalGapsWeight = value
+                onWeightReleased: root.rerank()
+            }
         }
 
         // Max Gaps Time sort
-        Item {
+        Column {
             width: parent.width
-            height: 50
+            spacing: 4
 
-            // Toggle Button
-            Rectangle {
-                id: maxGapsToggle
-                width: 60
-                height: 30
-                anchors.left: parent.left
-                anchors.verticalCenter: parent.verticalCenter
-                color: root.maxGapsTimeEnabled ? "#10b981" : "#374151"
-                radius: 15
-                border.width: 2
-                border.color: root.maxGapsTimeEnabled ? "#059669" : "#4b5563"
+            Item {
+                width: parent.width
+                height: 50
 
+                // Toggle Button
                 Rectangle {
-                    width: 22
-                    height: 22
-                    radius: 11
-                    color: "#ffffff"
-                    x: root.maxGapsTimeEnabled ? parent.width - width - 4 : 4
+                    id: maxGapsToggle
+                    width: 60
+                    height: 30
+                    anchors.left: parent.left
                     anchors.verticalCenter: parent.verticalCenter
+                    color: root.maxGapsTimeEnabled ? "#10b981" : "#374151"
+                    radius: 15
+                    border.width: 2
+                    border.color: root.maxGapsTimeEnabled ? "#059669" : "#4b5563"
 
-                    Behavior on x {
-                        NumberAnimation {
-                            duration: 200
+                    Rectangle {
+                        width: 22
+                        height: 22
+                        radius: 11
+                        color: "#ffffff"
+                        x: root.maxGapsTimeEnabled ? parent.width - width - 4 : 4
+                        anchors.verticalCenter: parent.verticalCenter
+
+                        Behavior on x {
+                            NumberAnimation {
+                                duration: 200
+                            }
                         }
                     }
-                }
 
-                MouseArea {
-                    anchors.fill: parent
-                    cursorShape: Qt.PointingHandCursor
-                    onClicked: {
-                        if (!root.maxGapsTimeEnabled) {
-                            disableAllSortsExcept("maxGapsTime")
-                            root.maxGapsTimeEnabled = true
-                        } else {
-                            root.maxGapsTimeEnabled = false
+                    MouseArea {
+                        anchors.fill: parent
+                        cursorShape: Qt.PointingHandCursor
+                        onClicked: {
+                            root.maxGapsTimeEnabled = !root.maxGapsTimeEnabled
                         }
                     }
                 }
-            }
-
-            Text {
-                id: gapsTimeTxt
-                text: "Max Gaps Time"
-                font.pixelSize: 16
-                color: "#ffffff"
-                anchors.left: maxGapsToggle.right
-                anchors.leftMargin: 15
-                anchors.verticalCenter: parent.verticalCenter
-            }
 
-            Text {
-                text: "(min)"
-                font.pixelSize: 10
-                color: "#ffffff"
-                anchors.left: gapsTimeTxt.right
-                anchors.leftMargin: 5
-                anchors.verticalCenter: parent.verticalCenter
-            }
-
-            // Ascending/Descending Toggle
-            Rectangle {
-                width: 120
-                height: 40
-                anchors.right: parent.right
-                anchors.verticalCenter: parent.verticalCenter
-                color: "#374151"
-                radius: 4
-                border.width: 1
-                border.color: "#4b5563"
+                Text {
+                    id: gapsTimeTxt
+                    text: "Max Gaps Time"
+                    font.pixelSize: 16
+                    color: "#ffffff"
+                    anchors.left: maxGapsToggle.right
+                    anchors.leftMargin: 15
+                    anchors.verticalCenter: parent.verticalCenter
+                }
 
-                Row {
-                    anchors.centerIn: parent
-                    spacing: 0
+                Text {
+                    text: "(min)"
+                    font.pixelSize: 10
+                    color: "#ffffff"
+                    anchors.left: gapsTimeTxt.right
+                    anchors.leftMargin: 5
+                    anchors.verticalCenter: parent.verticalCenter
+                }
 
-                    Rectangle {
-                        width: 60
-                        height: 38
-                        color: root.maxGapsTimeEnabled && root.maxGapsTimeAscending ? "#10b981" : "#4b5563"
-                        radius: 4
-                        border.width: 1
-                        border.color: "#374151"
-
-                        Text {
-                            text: "↑"
-                            font.pixelSize: 18
-                            font.bold: true
-                            color: "#ffffff"
-                            anchors.centerIn: parent
-                        }
+                // Ascending/Descending Toggle
+                Rectangle {
+                    width: 120
+                    height: 40
+                    anchors.right: parent.right
+                    anchors.verticalCenter: parent.verticalCenter
+                    color: "#374151"
+                    radius: 4
+                    border.width: 1
+                    border.color: "#4b5563"
+
+                    Row {
+                        anchors.centerIn: parent
+                        spacing: 0
+
+                        Rectangle {
+                            width: 60
+                            height: 38
+                            color: root.maxGapsTimeEnabled && root.maxGapsTimeAscending ? "#10b981" : "#4b5563"
+                            radius: 4
+                            border.width: 1
+                            border.color: "#374151"
+
+                            Text {
+                                text: "↑"
+                                font.pixelSize: 18
+                                font.bold: true
+                                color: "#ffffff"
+                                anchors.centerIn: parent
+                            }
 
 
-                        MouseArea {
-                            anchors.fill: parent
-                            cursorShape: Qt.PointingHandCursor
-                            enabled: root.maxGapsTimeEnabled
-                            onClicked: {
-                                root.maxGapsTimeAscending = true
+                            MouseArea {
+                                anchors.fill: parent
+                                cursorShape: Qt.PointingHandCursor
+                                enabled: root.maxGapsTimeEnabled
+                                onClicked: {
+                                    root.maxGapsTimeAscending = true
+                                }
                             }
                         }
-                    }
 
-                    Rectangle {
-                        width: 60
-                        height: 38
-                        color: root.maxGapsTimeEnabled && !root.maxGapsTimeAscending ? "#10b981" : "#4b5563"
-                        radius: 4
-                        border.width: 1
-                        border.color: "#374151"
-
-                        Text {
-                            text: "↓"
-                            font.pixelSize: 18
-                            font.bold: true
-                            color: "#ffffff"
-                            anchors.centerIn: parent
-                        }
+                        Rectangle {
+                            width: 60
+                            height: 38
+                            color: root.maxGapsTimeEnabled && !root.maxGapsTimeAscending ? "#10b981" : "#4b5563"
+                            radius: 4
+                            border.width: 1
+                            border.color: "#374151"
+
+                            Text {
+                                text: "↓"
+                                font.pixelSize: 18
+                                font.bold: true
+                                color: "#ffffff"
+                                anchors.centerIn: parent
+                            }
 
-                        MouseArea {
-                            anchors.fill: parent
-                            cursorShape: Qt.PointingHandCursor
-                            enabled: root.maxGapsTimeEnabled
-                            onClicked: {
-                                root.maxGapsTimeAscending = false
+                            MouseArea {
+                                anchors.fill: parent
+                                cursorShape: Qt.PointingHandCursor
+                                enabled: root.maxGapsTimeEnabled
+                                onClicked: {
+                                    root.maxGapsTimeAscending = false
+                                }
                             }
                         }
                     }
                 }
             }
+
+            WeightSlider {
+                width: parent.width
+                fieldEnabled: root.maxGapsTimeEnabled
+                onValueChanged: root.maxGapsTimeWeight = value
+                onWeightReleased: root.rerank()
+            }
         }
 
         // Avg Day Start sort
-        Item {
+        Column {
             width: parent.width
-            height: 50
+            spacing: 4
 
-            // Toggle Button
-            Rectangle {
-                id: startToggle
-                width: 60
-                height: 30
-                anchors.left: parent.left
-                anchors.verticalCenter: parent.verticalCenter
-                color: root.avgDayStartEnabled ? "#10b981" : "#374151"
-                radius: 15
-                border.width: 2
-                border.color: root.avgDayStartEnabled ? "#059669" : "#4b5563"
+            Item {
+                width: parent.width
+                height: 50
 
+                // Toggle Button
                 Rectangle {
-                    width: 22
-                    height: 22
-                    radius: 11
-                    color: "#ffffff"
-                    x: root.avgDayStartEnabled ? parent.width - width - 4 : 4
+                    id: startToggle
+                    width: 60
+                    height: 30
+                    anchors.left: parent.left
                     anchors.verticalCenter: parent.verticalCenter
+                    color: root.avgDayStartEnabled ? "#10b981" : "#374151"
+                    radius: 15
+                    border.width: 2
+                    border.color: root.avgDayStartEnabled ? "#059669" : "#4b5563"
 
-                    Behavior on x {
-                        NumberAnimation {
-                            duration: 200
+                    Rectangle {
+                        width: 22
+                        height: 22
+                        radius: 11
+                        color: "#ffffff"
+                        x: root.avgDayStartEnabled ? parent.width - width - 4 : 4
+                        anchors.verticalCenter: parent.verticalCenter
+
+                        Behavior on x {
+                            NumberAnimation {
+                                duration: 200
+                            }
                         }
                     }
-                }
 
-                MouseArea {
-                    anchors.fill: parent
-                    cursorShape: Qt.PointingHandCursor
-                    onClicked: {
-                        if (!root.avgDayStartEnabled) {
-                            disableAllSortsExcept("avgDayStart")
-                            root.avgDayStartEnabled = true
-                        } else {
-                            root.avgDayStartEnabled = false
+                    MouseArea {
+                        anchors.fill: parent
+                        cursorShape: Qt.PointingHandCursor
+                        onClicked: {
+                            root.avgDayStartEnabled = !root.avgDayStartEnabled
                         }
                     }
                 }
-            }
-
-            Text {
-                text: "Avg Day Start"
-                font.pixelSize: 16
-                color: "#ffffff"
-                anchors.left: startToggle.right
-                anchors.leftMargin: 15
-                anchors.verticalCenter: parent.verticalCenter
-            }
-
-            // Ascending/Descending Toggle
-            Rectangle {
-                width: 120
-                height: 40
-                anchors.right: parent.right
-                anchors.verticalCenter: parent.verticalCenter
-                color: "#374151"
-                radius: 4
-                border.width: 1
-                border.color: "#4b5563"
 
-                Row {
-                    anchors.centerIn: parent
-                    spacing: 0
+                Text {
+                    text: "Avg Day Start"
+                    font.pixelSize: 16
+                    color: "#ffffff"
+                    anchors.left: startToggle.right
+                    anchors.leftMargin: 15
+                    anchors.verticalCenter: parent.verticalCenter
+                }
 
-                    Rectangle {
-                        width: 60
-                        height: 38
-                        color: root.avgDayStartEnabled && root.avgDayStartAscending ? "#10b981" : "#4b5563"
-                        radius: 4
-                        border.width: 1
-                        border.color: "#374151"
-
-                        Text {
-                            text: "↑"
-                            font.pixelSize: 18
-                            font.bold: true
-                            color: "#ffffff"
-                            anchors.centerIn: parent
-                        }
+                // Ascending/Descending Toggle
+                Rectangle {
+                    width: 120
+                    height: 40
+                    anchors.right: parent.right
+                    anchors.verticalCenter: parent.verticalCenter
+                    color: "#374151"
+                    radius: 4
+                    border.width: 1
+                    border.color: "#4b5563"
+
+                    Row {
+                        anchors.centerIn: parent
+                        spacing: 0
+
+                        Rectangle {
+                            width: 60
+                            height: 38
+                            color: root.avgDayStartEnabled && root.avgDayStartAscending ? "#10b981" : "#4b5563"
+                            radius: 4
+                            border.width: 1
+                            border.color: "#374151"
+
+                            Text {
+                                text: "↑"
+                                font.pixelSize: 18
+                                font.bold: true
+                                color: "#ffffff"
+                                anchors.centerIn: parent
+                            }
 
-                        MouseArea {
-                            anchors.fill: parent
-                            cursorShape: Qt.PointingHandCursor
-                            enabled: root.avgDayStartEnabled
-                            onClicked: {
-                                root.avgDayStartAscending = true
+                            MouseArea {
+                                anchors.fill: parent
+                                cursorShape: Qt.PointingHandCursor
+                                enabled: root.avgDayStartEnabled
+                                onClicked: {
+                                    root.avgDayStartAscending = true
+                                }
                             }
                         }
-                    }
 
-                    Rectangle {
-                        width: 60
-                        height: 38
-                        color: root.avgDayStartEnabled && !root.avgDayStartAscending ? "#10b981" : "#4b5563"
-                        radius: 4
-                        border.width: 1
-                        border.color: "#374151"
-
-                        Text {
-                            text: "↓"
-                            font.pixelSize: 18
-                            font.bold: true
-                            color: "#ffffff"
-                            anchors.centerIn: parent
-                        }
+                        Rectangle {
+                            width: 60
+                            height: 38
+                            color: root.avgDayStartEnabled && !root.avgDayStartAscending ? "#10b981" : "#4b5563"
+                            radius: 4
+                            border.width: 1
+                            border.color: "#374151"
+
+                            Text {
+                                text: "↓"
+                                font.pixelSize: 18
+                                font.bold: true
+                                color: "#ffffff"
+                                anchors.centerIn: parent
+                            }
 
-                        MouseArea {
-                            anchors.fill: parent
-                            cursorShape: Qt.PointingHandCursor
-                            enabled: root.avgDayStartEnabled
-                            onClicked: {
-                                root.avgDayStartAscending = false
+                            MouseArea {
+                                anchors.fill: parent
+                                cursorShape: Qt.PointingHandCursor
+                                enabled: root.avgDayStartEnabled
+                                onClicked: {
+                                    root.avgDayStartAscending = false
+                                }
                             }
                         }
                     }
                 }
             }
+
+            WeightSlider {
+                width: parent.width
+                fieldEnabled: root.avgDayStartEnabled
+                onValueChanged: root.avgDayStartWeight = value
+                onWeightReleased: root.rerank()
+            }
         }
 
         // Avg Day End sort
-        Item {
+        Column {
             width: parent.width
-            height: 50
+            spacing: 4
 
-            // Toggle Button
-            Rectangle {
-                id: endToggle
-                width: 60
-                height: 30
-                anchors.left: parent.left
-                anchors.verticalCenter: parent.verticalCenter
-                color: root.avgDayEndEnabled ? "#10b981" : "#374151"
-                radius: 15
-                border.width: 2
-                border.color: root.avgDayEndEnabled ? "#059669" : "#4b5563"
+            Item {
+                width: parent.width
+                height: 50
 
+                // Toggle Button
                 Rectangle {
-                    width: 22
-                    height: 22
-                    radius: 11
-                    color: "#ffffff"
-                    x: root.avgDayEndEnabled ? parent.width - width - 4 : 4
+                    id: endToggle
+                    width: 60
+                    height: 30
+                    anchors.left: parent.left
                     anchors.verticalCenter: parent.verticalCenter
+                    color: root.avgDayEndEnabled ? "#10b981" : "#374151"
+                    radius: 15
+                    border.width: 2
+                    border.color: root.avgDayEndEnabled ? "#059669" : "#4b5563"
 
-                    Behavior on x {
-                        NumberAnimation {
-                            duration: 200
+                    Rectangle {
+                        width: 22
+                        height: 22
+                        radius: 11
+                        color: "#ffffff"
+                        x: root.avgDayEndEnabled ? parent.width - width - 4 : 4
+                        anchors.verticalCenter: parent.verticalCenter
+
+                        Behavior on x {
+                            NumberAnimation {
+                                duration: 200
+                            }
                         }
                     }
-                }
 
-                MouseArea {
-                    anchors.fill: parent
-                    cursorShape: Qt.PointingHandCursor
-                    onClicked: {
-                        if (!root.avgDayEndEnabled) {
-                            disableAllSortsExcept("avgDayEnd")
-                            root.avgDayEndEnabled = true
-                        } else {
-                            root.avgDayEndEnabled = false
+                    MouseArea {
+                        anchors.fill: parent
+                        cursorShape: Qt.PointingHandCursor
+                        onClicked: {
+                            root.avgDayEndEnabled = !root.avgDayEndEnabled
                         }
                     }
                 }
-            }
-
-            Text {
-                text: "Avg Day End"
-                font.pixelSize: 16
-                color: "#ffffff"
-                anchors.left: endToggle.right
-                anchors.leftMargin: 15
-                anchors.verticalCenter: parent.verticalCenter
-            }
-
-            // Ascending/Descending Toggle
-            Rectangle {
-                width: 120
-                height: 40
-                anchors.right: parent.right
-                anchors.verticalCenter: parent.verticalCenter
-                color: "#374151"
-                radius: 4
-                border.width: 1
-                border.color: "#4b5563"
 
-                Row {
-                    anchors.centerIn: parent
-                    spacing: 0
+                Text {
+                    text: "Avg Day End"
+                    font.pixelSize: 16
+                    color: "#ffffff"
+                    anchors.left: endToggle.right
+                    anchors.leftMargin: 15
+                    anchors.verticalCenter: parent.verticalCenter
+                }
 
-                    Rectangle {
-                        width: 60
-                        height: 38
-                        color: root.avgDayEndEnabled && root.avgDayEndAscending ? "#10b981" : "#4b5563"
-                        radius: 4
-                        border.width: 1
-                        border.color: "#374151"
-
-                        Text {
-                            text: "↑"
-                            font.pixelSize: 18
-                            font.bold: true
-                            color: "#ffffff"
-                            anchors.centerIn: parent
-                        }
+                // Ascending/Descending Toggle
+                Rectangle {
+                    width: 120
+                    height: 40
+                    anchors.right: parent.right
+                    anchors.verticalCenter: parent.verticalCenter
+                    color: "#374151"
+                    radius: 4
+                    border.width: 1
+                    border.color: "#4b5563"
+
+                    Row {
+                        anchors.centerIn: parent
+                        spacing: 0
+
+                        Rectangle {
+                            width: 60
+                            height: 38
+                            color: root.avgDayEndEnabled && root.avgDayEndAscending ? "#10b981" : "#4b5563"
+                            radius: 4
+                            border.width: 1
+                            border.color: "#374151"
+
+                            Text {
+                                text: "↑"
+                                font.pixelSize: 18
+                                font.bold: true
+                                color: "#ffffff"
+                                anchors.centerIn: parent
+                            }
 
-                        MouseArea {
-                            anchors.fill: parent
-                            cursorShape: Qt.PointingHandCursor
-                            enabled: root.avgDayEndEnabled
-                            onClicked: {
-                                root.avgDayEndAscending = true
+                            MouseArea {
+                                anchors.fill: parent
+                                cursorShape: Qt.PointingHandCursor
+                                enabled: root.avgDayEndEnabled
+                                onClicked: {
+                                    root.avgDayEndAscending = true
+                                }
                             }
                         }
-                    }
 
-                    Rectangle {
-                        width: 60
-                        height: 38
-                        color: root.avgDayEndEnabled && !root.avgDayEndAscending ? "#10b981" : "#4b5563"
-                        radius: 4
-                        border.width: 1
-                        border.color: "#374151"
-
-                        Text {
-                            text: "↓"
-                            font.pixelSize: 18
-                            font.bold: true
-                            color: "#ffffff"
-                            anchors.centerIn: parent
-                        }
+                        Rectangle {
+                            width: 60
+                            height: 38
+                            color: root.avgDayEndEnabled && !root.avgDayEndAscending ? "#10b981" : "#4b5563"
+                            radius: 4
+                            border.width: 1
+                            border.color: "#374151"
+
+                            Text {
+                                text: "↓"
+                                font.pixelSize: 18
+                                font.bold: true
+                                color: "#ffffff"
+                                anchors.centerIn: parent
+                            }
 
-                        MouseArea {
-                            anchors.fill: parent
-                            cursorShape: Qt.PointingHandCursor
-                            enabled: root.avgDayEndEnabled
-                            onClicked: {
-                                root.avgDayEndAscending = false
+                            MouseArea {
+                                anchors.fill: parent
+                                cursorShape: Qt.PointingHandCursor
+                                enabled: root.avgDayEndEnabled
+                                onClicked: {
+                                    root.avgDayEndAscending = false
+                                }
                             }
                         }
                     }
                 }
             }
+
+            WeightSlider {
+                width: parent.width
+                fieldEnabled: root.avgDayEndEnabled
+                onValueChanged: root.avgDayEndWeight = value
+                onWeightReleased: root.rerank()
+            }
         }
 
         // Apply sorting button
@@ -76,6 +76,11 @@ Page {
                 tableModel.updateRows()
             }
         }
+        function onCurrentVariantChanged() {
+            if (tableModel) {
+                tableModel.updateRows()
+            }
+        }
     }
 
     onDayColumnWidthChanged: {
@@ -367,6 +372,87 @@ Page {
                                 }
                             }
                         }
+
+                        // The same week in other groups or rooms
+                        RowLayout {
+                            id: variantRow
+                            spacing: 6
+                            visible: scheduleModel ? scheduleModel.variantCount > 1 : false
+
+                            property int variant: scheduleModel ? scheduleModel.currentVariant : 0
+                            property int variants: scheduleModel ? scheduleModel.variantCount : 0
+
+                            Rectangle {
+                                Layout.preferredWidth: 1
+                                Layout.preferredHeight: 28
+                                color: "#cbd5e1"
+                            }
+
+                            Label {
+                                text: "Rooms"
+                                font.pixelSize: 13
+                                color: "#475569"
+                            }
+
+                            Rectangle {
+                                radius: 6
+                                width: 28
+                                height: 28
+                                property bool isEnabled: variantRow.variant > 0
+                                color: !isEnabled ? "#e5e7eb" : (prevVariantMouseArea.containsMouse ? "#35455c" : "#1f2937")
+                                opacity: isEnabled ? 1.0 : 0.5
+
+                                Text {
+                                    text: "‹"
+                                    anchors.centerIn: parent
+                                    color: parent.isEnabled ? "white" : "#9ca3af"
+                                    font.pixelSize: 16
+                                    font.bold: true
+                                }
+
+                                MouseArea {
+                                    id: prevVariantMouseArea
+                                    anchors.fill: parent
+                                    hoverEnabled: parent.isEnabled
+                                    cursorShape: parent.isEnabled ? Qt.PointingHandCursor : Qt.ForbiddenCursor
+                                    enabled: parent.isEnabled
+                                    onClicked: scheduleModel.previousVariant()
+                                }
+                            }
+
+                            Label {
+                                text: (variantRow.variant + 1) + " / " + variantRow.variants
+                                font.pixelSize: 13
+                                font.weight: Font.Medium
+                                color: "#1d4ed8"
+                            }
+
+                            Rectangle {
+                                radius: 6
+                                width: 28
+                                height: 28
+                                property bool isEnabled: variantRow.variant + 1 < variantRow.variants
+                                color: !isEnabled ? "#e5e7eb" : (nextVariantMouseArea.containsMouse ? "#35455c" : "#1f2937")
+                                opacity: isEnabled ? 1.0 : 0.5
+
+                                Text {
+                                    text: "›"
+                                    anchors.centerIn: parent
+                                    color: parent.isEnabled ? "white" : "#9ca3af"
+                                    font.pixelSize: 16
+                                    font.bold: true
+                                }
+
+                                MouseArea {
+                                    id: nextVariantMouseArea
+                                    anchors.fill: parent
+                                    hoverEnabled: parent.isEnabled
+                                    cursorShape: parent.isEnabled ? Qt.PointingHandCursor : Qt.ForbiddenCursor
+                                    enabled: parent.isEnabled
+                                    onClicked: scheduleModel.nextVariant()
+                                }
+                            }
+                        }
                     }
                 }
             }